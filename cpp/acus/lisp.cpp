@@ -6,8 +6,13 @@
 
 #include "lisp.hpp"
 
+#include "cento/centoParallel.hpp"
+
 #include <algorithm>
 #include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <fmt/format.h>
 
@@ -205,6 +210,51 @@ namespace grammar
 
 }
 
+// Place the instances of a symbol as one array when they fill a regular
+// grid, as the repeated cells of a memory or a resistor bank do.
+bool placeArray(cento::Cell& top, const cento::Cell& cell, std::vector<cento::Point> origins)
+{
+    std::ranges::sort(origins);
+    if (std::ranges::adjacent_find(origins) != origins.end()) { return false; }
+
+    std::vector<i32> xs;
+    std::vector<i32> ys;
+    for (const cento::Point& p : origins)
+    {
+        xs.push_back(p.x);
+        ys.push_back(p.y);
+    }
+    for (std::vector<i32>* v : {&xs, &ys})
+    {
+        std::ranges::sort(*v);
+        v->erase(std::unique(v->begin(), v->end()), v->end());
+    }
+
+    // the origins are distinct so filling every column and row with as
+    // many origins means the grid is full
+    if (xs.size() * ys.size() != origins.size()) { return false; }
+
+    auto pitchOf = [](const std::vector<i32>& v) -> i32
+    {
+        if (v.size() == 1) { return 0; }
+
+        const i32 pitch = v[1] - v[0];
+        for (usize i = 2; i < v.size(); ++i)
+        {
+            if (v[i] - v[i - 1] != pitch) { return -1; }
+        }
+
+        return pitch;
+    };
+    const i32 px = pitchOf(xs);
+    const i32 py = pitchOf(ys);
+    if ((px < 0) || (py < 0)) { return false; }
+
+    cento::place(top, cell, {xs.front(), ys.front()}, i32(xs.size()), i32(ys.size()), {px, py});
+
+    return true;
+}
+
 }
 
 int testLisp()
@@ -242,16 +292,18 @@ int testLisp()
     return count;
 }
 
-std::vector<cento::Rect> parseLisp(const std::string_view path)
+namespace
+{
+
+// Read the symbols and instances of the file in the order they are written.
+bool readPlan(const std::string_view path, ast::plan& plan)
 {
     auto file = lexy::read_file<lexy::utf8_encoding>(path.data());
-    if (!file) { return {}; }
+    if (!file) { return false; }
 
     const auto document = lexy::parse<grammar::lisp>(
         file.buffer(), lexy_ext::report_error.path(path.data()));
-    if (!document) { return {}; }
-
-    ast::plan plan;
+    if (!document) { return false; }
 
     const std::vector<ast::statement>& statements = document.value();
     for (const ast::statement& s : statements)
@@ -274,7 +326,6 @@ std::vector<cento::Rect> parseLisp(const std::string_view path)
         }, s.v);
     }
 
-    std::vector<cento::Rect> rects;
     for (const ast::symbol& sym : plan.symbols)
     {
         fmt::print("sym: \"{}\" pad count {}\n", sym.name, sym.pads.size());
@@ -284,23 +335,117 @@ std::vector<cento::Rect> parseLisp(const std::string_view path)
         fmt::print("inst: \"{}\" ({}, {})\n", inst.symbol, inst.origin.x, inst.origin.y);
     }
 
-    for (const ast::instance& inst : plan.instances)
+    return true;
+}
+
+}
+
+bool parseLispLayout(const std::string_view path, Layout& layout)
+{
+    ast::plan plan;
+    if (not readPlan(path, plan)) { return false; }
+
+    // each symbol is built once into a cell of its own, the first symbol of a
+    // name is the one instances refer to.  A cell cannot hold pads which
+    // overlap, so a symbol with them is an error rather than losing pads.
+    bool                                                 overlapping = false;
+    std::unordered_map<std::string, const cento::Cell*> cells;
+    for (const ast::symbol& sym : plan.symbols)
     {
-        auto s = std::ranges::find_if(plan.symbols, [&](const ast::symbol& sym)
+        if (cells.contains(sym.name)) { continue; }
+
+        cento::Cell& cell = layout.symbols.emplace_back();
+        cento::createUniverse(cell);
+
+        u64 id = 0;
+        for (const cento::Rect& r : sym.pads)
         {
-            return sym.name == inst.symbol;
-        });
-        if (s == cend(plan.symbols))
+            if (cento::insertTile(cell, {.id = id++, .rect = r}) == nullptr)
+            {
+                fmt::print(stderr, "{}: error: overlapping pad in symbol \"{}\": ({}, {}) - ({}, {})\n",
+                           path, sym.name, r.ll.x, r.ll.y, r.ur.x, r.ur.y);
+                overlapping = true;
+            }
+        }
+
+        cells.emplace(sym.name, &cell);
+    }
+    if (overlapping) { return false; }
+
+    // gather the instances of each symbol so that those laid out on a grid
+    // can be placed as a single array
+    std::vector<std::string>                                   order;
+    std::unordered_map<std::string, std::vector<cento::Point>> origins;
+    for (const ast::instance& inst : plan.instances)
+    {
+        if (not cells.contains(inst.symbol))
         {
             fmt::print("missing symbol: \"{}\"\n", inst.symbol);
             continue;
         }
 
-        for (const cento::Rect& r : s->pads)
+        std::vector<cento::Point>& o = origins[inst.symbol];
+        if (o.empty()) { order.push_back(inst.symbol); }
+        o.push_back(inst.origin);
+    }
+
+    cento::createUniverse(layout.top);
+    for (const std::string& name : order)
+    {
+        const cento::Cell&               cell = *cells.at(name);
+        const std::vector<cento::Point>& o    = origins.at(name);
+        if ((o.size() > 1) && placeArray(layout.top, cell, o)) { continue; }
+
+        for (const cento::Point& p : o) { cento::place(layout.top, cell, p); }
+    }
+
+    return true;
+}
+
+std::vector<cento::Rect> parseLisp(const std::string_view path)
+{
+    ast::plan plan;
+    if (not readPlan(path, plan)) { return {}; }
+
+    // the pads of each instance follow those of the one before in the order
+    // of the file, so the slice of the output each instance is copied to is
+    // known up front and the copies are made in parallel
+    // the first symbol of a name is the one instances refer to
+    std::unordered_map<std::string_view, const ast::symbol*> symbols;
+    symbols.reserve(plan.symbols.size());
+    for (const ast::symbol& sym : plan.symbols) { symbols.try_emplace(sym.name, &sym); }
+
+    std::vector<const ast::symbol*> shapes;
+    std::vector<cento::Point>       origins;
+    std::vector<usize>              base = {0};
+    shapes.reserve(plan.instances.size());
+    origins.reserve(plan.instances.size());
+    base.reserve(plan.instances.size() + 1);
+    for (const ast::instance& inst : plan.instances)
+    {
+        const auto s = symbols.find(inst.symbol);
+        if (s == symbols.end())
         {
-            rects.emplace_back(cento::translate(r, inst.origin));
+            fmt::print("missing symbol: \"{}\"\n", inst.symbol);
+            continue;
         }
+
+        shapes.push_back(s->second);
+        origins.push_back(inst.origin);
+        base.push_back(base.back() + s->second->pads.size());
     }
 
+    std::vector<cento::Rect> rects(base.back());
+    cento::detail::parallelFor(shapes.size(), 64, cento::detail::workerCount(), [&](usize, const usize begin, const usize end)
+    {
+        for (usize i = begin; i < end; ++i)
+        {
+            std::ranges::transform(shapes[i]->pads, rects.begin() + base[i], [&](const cento::Rect& r)
+            {
+                return cento::translate(r, origins[i]);
+            });
+        }
+    });
+
     return rects;
 }
@@ -9,12 +9,23 @@
 
 #pragma once
 
+#include <deque>
 #include <string_view>
 #include <vector>
 
+#include "cento/centoCell.hpp"
 #include "cento/centoRect.hpp"
 
+// A layout kept as its hierarchy, a cell for each symbol and a top cell
+// holding the instances of them.
+struct Layout
+{
+    std::deque<cento::Cell> symbols;
+    cento::Cell             top;
+};
+
 int                      testLisp();
+bool                     parseLispLayout(const std::string_view path, Layout& layout);
 std::vector<cento::Rect> parseLisp(const std::string_view path);
 
 #endif // lisp_hpp
@@ -5,13 +5,19 @@
 //
 
 #include "cento/centoRect.hpp"
+#include "cento/centoCell.hpp"
+#include "cento/centoCompact.hpp"
 #include "cento/centoCreate.hpp"
 #include "cento/centoInsert.hpp"
 #include "cento/centoRemove.hpp"
+#include "cento/centoRoute.hpp"
 
 #include <array>
+#include <chrono>
+#include <charconv>
 #include <iostream>
 #include <fstream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -162,10 +168,8 @@ namespace
             if (tile == nullptr)
             {
                 print_tile("failed to insert tile", plan);
-                cento::query(plane, r, [](cento::Tile* t)
+                cento::querySolid(plane, r, [](cento::Tile* t)
                 {
-                    if (isSpace(t)) { return; }
-
                     print_tile("overlaps with tile", t);
                 });
                 continue;
@@ -229,13 +233,222 @@ namespace
         return 0;
     }
 
+    int runCells(const std::string_view path)
+    {
+        Layout layout;
+        if (not parseLispLayout(path, layout))
+        {
+            fmt::print(stderr, "{} could not be parsed\n", path);
+            return 1;
+        }
+
+        usize stored = 0;
+        for (const cento::Cell& cell : layout.symbols)
+        {
+            cento::queryAll(cell.plane, [&](cento::Tile* t) { if (isSolid(t)) { ++stored; } });
+        }
+
+        const usize placed = cento::parallelFlatten(layout.top).size();
+
+        fmt::print("cell count {}, instance count {}\n", layout.symbols.size(), layout.top.placements.size());
+        fmt::print("tiles stored {}, tiles placed {}\n", stored, placed);
+
+        return 0;
+    }
+
+    /*
+     * Fill the plane with the layout tiled scale by scale times over, so that
+     * the small testcases make a plane worth measuring.  Returns the extent of
+     * the tiled layout.
+     */
+    cento::Rect tileLayout(cento::Plane&                   plane,
+                           const std::vector<cento::Rect>& rects,
+                           const i32                       scale)
+    {
+        cento::Rect extent = rects.front();
+        for (const cento::Rect& r : rects) { extent = cento::boundingBox(extent, r); }
+        const i32 w = extent.ur.x - extent.ll.x + 100;
+        const i32 h = extent.ur.y - extent.ll.y + 100;
+
+        cento::createUniverse(plane);
+
+        u64 id = 0;
+        for (i32 row = 0; row < scale; ++row)
+        {
+            for (i32 column = 0; column < scale; ++column)
+            {
+                for (const cento::Rect& r : rects)
+                {
+                    const cento::Rect moved = cento::translate(r, {column * w, row * h});
+                    cento::insertTile(plane, {.id = id++, .rect = moved});
+                }
+            }
+        }
+
+        usize count = 0;
+        cento::queryAll(plane, [&](cento::Tile* t) { if (isSolid(t)) { ++count; } });
+        fmt::print("tile count {} ({} x {} copies)\n", count, scale, scale);
+
+        return {extent.ll, {extent.ll.x + scale * w, extent.ll.y + scale * h}};
+    }
+
+    /*
+     * Time compacting the layout both ways.
+     */
+    int runCompact(const std::vector<cento::Rect>& rects,
+                   const std::string_view          path,
+                   const i32                       scale)
+    {
+        if (rects.empty())
+        {
+            fmt::print(stderr, "{} contains no valid rectangles\n", path);
+            return 1;
+        }
+
+        cento::Plane plane;
+        tileLayout(plane, rects, scale);
+
+        for (const cento::Axis axis : {cento::Axis::Horizontal, cento::Axis::Vertical})
+        {
+            const auto  start = std::chrono::steady_clock::now();
+            const usize moved = cento::compact(plane, axis, [](u64, u64) { return 10; });
+            const auto  end   = std::chrono::steady_clock::now();
+
+            fmt::print("compacted {}: {} tiles moved in {} ms\n",
+                       (axis == cento::Axis::Horizontal) ? "left" : "down",
+                       moved,
+                       std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+        }
+
+        return validate_tiling(plane) ? 0 : 2;
+    }
+
+    /*
+     * The shortest route between two points by a breadth first search of the
+     * grid of the area, the way a router working on a raster would find it.
+     * Returns the length of the route, or -1 if there is none.
+     */
+    i64 gridRoute(const std::vector<bool>& blocked,
+                  const cento::Rect&       area,
+                  const cento::Point       from,
+                  const cento::Point       to)
+    {
+        const i64 w     = i64(area.ur.x) - area.ll.x;
+        const i64 h     = i64(area.ur.y) - area.ll.y;
+        auto      index = [&](const i64 x, const i64 y) { return usize((y - area.ll.y) * w + (x - area.ll.x)); };
+
+        std::vector<i64>                 dist(blocked.size(), -1);
+        std::vector<std::pair<i64, i64>> open = {{from.x, from.y}};
+        dist[index(from.x, from.y)] = 0;
+        for (usize next = 0; next < open.size(); ++next)
+        {
+            const auto [x, y] = open[next];
+            if ((x == to.x) && (y == to.y)) { break; }
+
+            const std::array<std::pair<i64, i64>, 4> around = {{{x + 1, y}, {x - 1, y}, {x, y + 1}, {x, y - 1}}};
+            for (const auto& [nx, ny] : around)
+            {
+                if ((nx < area.ll.x) || (ny < area.ll.y) || (nx >= area.ll.x + w) || (ny >= area.ll.y + h)) { continue; }
+
+                const usize n = index(nx, ny);
+                if (blocked[n] || (dist[n] >= 0)) { continue; }
+
+                dist[n] = dist[index(x, y)] + 1;
+                open.push_back({nx, ny});
+            }
+        }
+
+        return dist[index(to.x, to.y)];
+    }
+
+    /*
+     * Time routing between random points of the layout over the space tiles,
+     * against a search of the grid of the layout when that fits in memory.
+     */
+    int runRoute(const std::vector<cento::Rect>& rects,
+                 const std::string_view          path,
+                 const i32                       scale)
+    {
+        if (rects.empty())
+        {
+            fmt::print(stderr, "{} contains no valid rectangles\n", path);
+            return 1;
+        }
+
+        cento::Plane      plane;
+        const cento::Rect extent = tileLayout(plane, rects, scale);
+
+        std::mt19937                       rng(1);
+        std::uniform_int_distribution<i32> xs(extent.ll.x, extent.ur.x - 1);
+        std::uniform_int_distribution<i32> ys(extent.ll.y, extent.ur.y - 1);
+        auto pick = [&]()
+        {
+            cento::Point p{xs(rng), ys(rng)};
+            while (isSolid(cento::findTileAt(plane, p))) { p = {xs(rng), ys(rng)}; }
+            return p;
+        };
+
+        constexpr usize count = 100;
+        std::vector<std::pair<cento::Point, cento::Point>> pairs;
+        for (usize i = 0; i < count; ++i) { pairs.push_back({pick(), pick()}); }
+
+        i64 tileLength = 0;
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& [from, to] : pairs)
+            {
+                const std::vector<cento::Point> route = cento::routePath(plane, from, to, 1);
+                for (usize i = 1; i < route.size(); ++i)
+                {
+                    tileLength += std::abs(i64(route[i].x) - route[i - 1].x) + std::abs(i64(route[i].y) - route[i - 1].y);
+                }
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            fmt::print("tile router: {} routes, length {}, in {} ms\n",
+                       count,
+                       tileLength,
+                       std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+        }
+
+        const i64 cells = (i64(extent.ur.x) - extent.ll.x) * (i64(extent.ur.y) - extent.ll.y);
+        if (cells > (i64(1) << 28))
+        {
+            fmt::print("grid router: skipped, {} cells is too many\n", cells);
+            return 0;
+        }
+
+        const auto        start = std::chrono::steady_clock::now();
+        std::vector<bool> blocked(usize(cells), false);
+        const i64         w = i64(extent.ur.x) - extent.ll.x;
+        cento::querySolid(plane, extent, [&](cento::Tile* t)
+        {
+            const cento::Rect r = cento::intersection(getRect(t), extent);
+            for (i64 y = r.ll.y; y < r.ur.y; ++y)
+            {
+                for (i64 x = r.ll.x; x < r.ur.x; ++x) { blocked[usize((y - extent.ll.y) * w + (x - extent.ll.x))] = true; }
+            }
+        });
+
+        i64 gridLength = 0;
+        for (const auto& [from, to] : pairs) { gridLength += std::max<i64>(gridRoute(blocked, extent, from, to), 0); }
+        const auto end = std::chrono::steady_clock::now();
+
+        fmt::print("grid router: {} routes, length {}, in {} ms\n",
+                   count,
+                   gridLength,
+                   std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+
+        return 0;
+    }
+
 }
 
 int main(const int argc, const char* argv[])
 {
     if (argc < 2)
     {
-        fmt::print(stderr, "usage: {} <type> [filename]\n", argv[0]);
+        fmt::print(stderr, "usage: {} <type> [filename] [scale]\n", argv[0]);
         return 1;
     }
 
@@ -248,7 +461,7 @@ int main(const int argc, const char* argv[])
 
     if (argc < 3)
     {
-        fmt::print(stderr, "usage: {} <type> [filename]\n", argv[0]);
+        fmt::print(stderr, "usage: {} <type> [filename] [scale]\n", argv[0]);
         return 1;
     }
 
@@ -258,6 +471,32 @@ int main(const int argc, const char* argv[])
     {
         return runCento(parseLisp(path), path);
     }
+    if (type == "cells")
+    {
+        return runCells(path);
+    }
+    if (type == "compact")
+    {
+        i32 scale = 1;
+        if (argc > 3)
+        {
+            const std::string_view arg{argv[3]};
+            std::from_chars(arg.data(), arg.data() + arg.size(), scale);
+        }
+
+        return runCompact(parseLisp(path), path, std::max(scale, 1));
+    }
+    if (type == "route")
+    {
+        i32 scale = 1;
+        if (argc > 3)
+        {
+            const std::string_view arg{argv[3]};
+            std::from_chars(arg.data(), arg.data() + arg.size(), scale);
+        }
+
+        return runRoute(parseLisp(path), path, std::max(scale, 1));
+    }
     if (type == "midi")
     {
         return runCento(parseMidi(path), path);
@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+//
+// Times buildPlane against inserting the same tiles one at a time, both in
+// the order given and sorted bottom to top.  The speed up is against the
+// sorted inserts.
+//
+//   cento_bench_build [tiles]
+//
+
+#include "cento/cento.hpp"
+#include "cento/centoBuild.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+    // One tile of random size in each cell of a square grid, so that no two
+    // overlap, with one in eight tall enough to run on over the cells above.
+    std::vector<cento::TilePlan> gridPlans(const usize count)
+    {
+        const i32 side = i32(std::ceil(std::sqrt(double(count))));
+
+        std::mt19937                       rng(3);
+        std::uniform_int_distribution<i32> size(1, 30);
+        std::uniform_int_distribution<i32> tall(0, 7);
+
+        std::vector<cento::TilePlan> plans;
+        plans.reserve(count);
+        for (i32 i = 0; plans.size() < count; ++i)
+        {
+            const i32 x = (i % side) * 40;
+            const i32 y = (i / side) * 40;
+            const i32 h = (tall(rng) == 0) ? 40 * 4 + size(rng) : size(rng);
+
+            // the tall ones take the whole column of the cells they cover
+            plans.push_back({.id = u64(i % 5), .rect = {{x, y}, {x + size(rng), y + h}}});
+            if (h > 40) { i += 4 * side; }
+        }
+        std::ranges::shuffle(plans, rng);
+
+        return plans;
+    }
+
+    template <typename F>
+    double millis(F&& f)
+    {
+        double best = 1e300;
+        for (i32 run = 0; run < 3; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+
+        return best;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const usize count = (argc > 1) ? usize(std::atoll(argv[1])) : 50000;
+    const std::vector<cento::TilePlan> plans = gridPlans(count);
+
+    std::printf("%zu tiles, %zu workers\n", plans.size(), cento::detail::workerCount());
+
+    const double one = millis([&]()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        for (const cento::TilePlan& plan : plans) { cento::insertTile(plane, plan); }
+    });
+    std::printf("%-20s %10.1f ms\n", "insertTile", one);
+
+    // the same order buildPlane inserts each band in, bottom to top
+    const double base = millis([&]()
+    {
+        std::vector<cento::TilePlan> sorted = plans;
+        std::ranges::sort(sorted, {}, [](const cento::TilePlan& p) { return std::pair{p.rect.ll.y, p.rect.ll.x}; });
+
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        for (const cento::TilePlan& plan : sorted) { cento::insertTile(plane, plan); }
+    });
+    std::printf("%-20s %10.1f ms\n", "insertTile sorted", base);
+
+    for (const usize bands : {usize(1), usize(2), usize(4), usize(8), usize(16), usize(0)})
+    {
+        const double t = millis([&]()
+        {
+            cento::Plane plane;
+            cento::buildPlane(plane, plans, bands);
+        });
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "buildPlane %zu", (bands == 0) ? cento::detail::workerCount() : bands);
+        std::printf("%-20s %10.1f ms %6.2fx\n", name, t, base / t);
+    }
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+//
+// Times reads of a shared plane made from several threads at once, first
+// with the readers alone and then alongside a writer editing now and then.
+//
+//   cento_bench_shared [reads per thread]
+//
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoRemove.hpp"
+#include "cento/centoShared.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    constexpr const i32 Side = 100;
+
+    // A grid of small tiles with a gap beside each.
+    void layGrid(cento::SharedPlane& shared)
+    {
+        cento::write(shared, [](cento::Plane& p)
+        {
+            cento::createUniverse(p);
+            for (i32 y = 0; y < Side; ++y)
+            {
+                for (i32 x = 0; x < Side; ++x)
+                {
+                    cento::insertTile(p, {.id = u64(y * Side + x), .rect = {{x * 20, y * 20}, {x * 20 + 10, y * 20 + 10}}});
+                }
+            }
+        });
+    }
+
+    // Look up a point and count the tiles in a small window, reads apart.
+    usize readMany(const cento::SharedPlane& shared, const i32 seed, const usize reads)
+    {
+        usize found = 0;
+        i32   i     = seed;
+        for (usize r = 0; r < reads; ++r)
+        {
+            i = (i * 7919 + 13) % (Side * Side);
+            const i32 x = (i % Side) * 20;
+            const i32 y = (i / Side) * 20;
+
+            found += cento::read(shared, [&](cento::PlaneReader& reader)
+            {
+                usize count = isSolid(cento::findTileAt(reader, {x + 5, y + 5})) ? 1 : 0;
+                cento::querySolid(reader, {{x, y}, {x + 40, y + 40}}, [&](cento::Tile*) { ++count; });
+                return count;
+            });
+        }
+
+        return found;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const usize reads = (argc > 1) ? usize(std::atoll(argv[1])) : 200000;
+
+    std::printf("%zu reads per thread, %u hardware threads\n", reads, std::thread::hardware_concurrency());
+
+    for (const bool writing : {false, true})
+    {
+        double one = 0.0;
+        for (const i32 threads : {1, 2, 4, 8})
+        {
+            cento::SharedPlane shared;
+            layGrid(shared);
+
+            std::atomic<bool>  done{false};
+            std::atomic<usize> found{0};
+
+            const auto start = std::chrono::steady_clock::now();
+            {
+                std::jthread writer;
+                if (writing)
+                {
+                    writer = std::jthread([&]()
+                    {
+                        for (i32 i = 0; not done.load(std::memory_order_relaxed); ++i)
+                        {
+                            const i32 x = (i % Side) * 20 + 12;
+                            cento::Tile* t = cento::write(shared, [&](cento::Plane& p)
+                            {
+                                return cento::insertTile(p, {.id = u64(Side * Side), .rect = {{x, 2}, {x + 6, 8}}});
+                            });
+                            cento::write(shared, [&](cento::Plane& p) { cento::removeTile(p, t); });
+                            std::this_thread::sleep_for(std::chrono::microseconds(50));
+                        }
+                    });
+                }
+
+                std::vector<std::jthread> readers;
+                for (i32 w = 0; w < threads; ++w)
+                {
+                    readers.emplace_back([&, w]() { found.fetch_add(readMany(shared, w, reads)); });
+                }
+                readers.clear();
+                done = true;
+            }
+            const auto stop = std::chrono::steady_clock::now();
+
+            const double seconds = std::chrono::duration<double>(stop - start).count();
+            const double rate    = double(reads) * threads / seconds;
+            if (threads == 1) { one = rate; }
+
+            std::printf("%s %2d threads %12.0f reads/s %6.2fx\n", writing ? "with writer" : "readers    ", threads, rate, rate / one);
+        }
+    }
+
+    return 0;
+}
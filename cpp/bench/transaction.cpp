@@ -0,0 +1,83 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+//
+// Times edits of a transactional plane made from several threads at once,
+// each thread keeping to a column of the plane of its own.
+//
+//   cento_bench_transaction [edits per thread]
+//
+
+#include "cento/cento.hpp"
+#include "cento/centoTransaction.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    constexpr const i32 Column = 400;
+
+    // Courses of bricks with a gap beside each brick, as in the tests.
+    void layBricks(cento::TransactionalPlane& tp, const i32 width, const i32 courses)
+    {
+        cento::createUniverse(tp);
+        for (i32 c = 0; c < courses; ++c)
+        {
+            for (i32 x = (c % 2) * 10; x < width; x += 20)
+            {
+                cento::insertTile(tp, {.id = 1, .rect = {{x, c * 10}, {x + 10, c * 10 + 10}}});
+            }
+        }
+    }
+
+    // Fill and clear the gaps in the middle of the column over and over.
+    void churn(cento::TransactionalPlane& tp, const i32 column, const usize edits)
+    {
+        for (usize i = 0; i < edits; ++i)
+        {
+            const i32 y = 100 + i32(i % 20) * 10;
+            const i32 x = column * Column + 100 + ((y / 10) % 2) * 10 + i32((i / 20) % 10) * 20;
+
+            cento::Tile* const t = cento::insertTile(tp, {.id = 2, .rect = {{x + 12, y + 2}, {x + 18, y + 8}}});
+            cento::removeTile(tp, t);
+        }
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const usize edits = (argc > 1) ? usize(std::atoll(argv[1])) : 20000;
+
+    std::printf("%zu edits per thread, %u hardware threads\n", edits, std::thread::hardware_concurrency());
+
+    double one = 0.0;
+    for (const i32 threads : {1, 2, 4, 8})
+    {
+        cento::TransactionalPlane tp;
+        layBricks(tp, threads * Column, 50);
+
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> workers;
+            for (i32 w = 0; w < threads; ++w) { workers.emplace_back(churn, std::ref(tp), w, edits); }
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(stop - start).count();
+        const double rate    = double(edits) * 2.0 * threads / seconds;
+        if (threads == 1) { one = rate; }
+
+        std::printf("%2d threads %12.0f edits/s %6.2fx\n", threads, rate, rate / one);
+    }
+
+    return 0;
+}
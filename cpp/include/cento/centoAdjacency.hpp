@@ -0,0 +1,134 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoAdjacency_hpp
+#define centoAdjacency_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoExplore.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * A graph of which solid tiles touch each other stored in compressed sparse
+ * row form, the neighbours of tile i are neighbours[offsets[i], offsets[i + 1])
+ * with the length of the edge they share in the same slots of lengths.  Every
+ * edge is stored in both directions.
+ */
+struct Adjacency
+{
+    std::vector<Tile*> tiles;
+    std::vector<u32>   offsets;
+    std::vector<u32>   neighbours;
+    std::vector<i64>   lengths;
+};
+
+CENTO_FORCEINLINE std::span<const u32> adjacent(const Adjacency& graph, const u32 tile)
+{
+    const u32 begin = graph.offsets[tile];
+    const u32 end   = graph.offsets[tile + 1];
+
+    return {graph.neighbours.data() + begin, end - begin};
+}
+
+CENTO_FORCEINLINE std::span<const i64> sharedLengths(const Adjacency& graph, const u32 tile)
+{
+    const u32 begin = graph.offsets[tile];
+    const u32 end   = graph.offsets[tile + 1];
+
+    return {graph.lengths.data() + begin, end - begin};
+}
+
+/*
+ * Build the adjacency graph of the solid tiles overlapping the area.
+ *
+ * The plane is walked once, for each solid tile only the neighbours along its
+ * right and top edges are looked at (through the stored stitches) so each
+ * touching pair is found exactly once.  Neighbours are numbered the first time
+ * they are seen so the graph can be built without a second walk.
+ */
+CENTO_FORCEINLINE Adjacency buildAdjacency(const Plane& plane, const Rect& area)
+{
+    struct Link
+    {
+        u32 from;
+        u32 to;
+        i64 length;
+    };
+
+    Adjacency                            graph;
+    std::unordered_map<const Tile*, u32> index;
+    std::vector<Link>                    links;
+
+    auto indexOf = [&](Tile* t)
+    {
+        const auto [it, inserted] = index.try_emplace(t, u32(graph.tiles.size()));
+        if (inserted) { graph.tiles.push_back(t); }
+
+        return it->second;
+    };
+
+    querySolid(plane, area, [&](Tile* t)
+    {
+        const u32 from = indexOf(t);
+
+        rightTiles(t, [&](Tile* r)
+        {
+            if (isSpace(r) || not overlaps(getRect(r), area)) { return; }
+
+            const i64 length = i64(std::min(getTop(t), getTop(r))) -
+                               std::max(getBottom(t), getBottom(r));
+            links.push_back({from, indexOf(r), length});
+        });
+
+        topTiles(t, [&](Tile* a)
+        {
+            if (isSpace(a) || not overlaps(getRect(a), area)) { return; }
+
+            const i64 length = i64(std::min(getRight(t), getRight(a))) -
+                               std::max(getLeft(t), getLeft(a));
+            links.push_back({from, indexOf(a), length});
+        });
+    });
+
+    graph.offsets.assign(graph.tiles.size() + 1, 0);
+    for (const Link& l : links)
+    {
+        ++graph.offsets[l.from + 1];
+        ++graph.offsets[l.to + 1];
+    }
+    for (usize i = 1; i < graph.offsets.size(); ++i)
+    {
+        graph.offsets[i] += graph.offsets[i - 1];
+    }
+
+    graph.neighbours.resize(links.size() * 2);
+    graph.lengths.resize(links.size() * 2);
+
+    std::vector<u32> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const Link& l : links)
+    {
+        graph.neighbours[fill[l.from]] = l.to;
+        graph.lengths[fill[l.from]++]  = l.length;
+        graph.neighbours[fill[l.to]]   = l.from;
+        graph.lengths[fill[l.to]++]    = l.length;
+    }
+
+    return graph;
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoAdjacency_hpp
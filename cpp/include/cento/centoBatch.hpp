@@ -0,0 +1,160 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoBatch_hpp
+#define centoBatch_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoExplore.hpp"
+#include "centoParallel.hpp"
+#include "centoPlane.hpp"
+
+#include <concepts>
+#include <functional>
+#include <span>
+#include <vector>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    template <bool SolidOnly, typename F> requires std::invocable<F&, usize, Tile*>
+    void queryBatch(const Plane&               plane,
+                    const std::span<const Rect> areas,
+                    F&                          callback)
+    {
+        // Each worker starts from the planes hint and then keeps its own, the
+        // plane itself is never written so any number of batches may run on
+        // the same plane as long as nothing is editing it.
+        const usize                   workers = workerCount();
+        std::vector<PerWorker<Tile*>> hints(workers, {plane.hint});
+
+        parallelFor(areas.size(), 64, workers, [&](usize worker, usize begin, usize end)
+        {
+            Tile* hint = hints[worker].value;
+            for (usize i = begin; i < end; ++i)
+            {
+                queryArea<SolidOnly>(hint, areas[i], [&](Tile* t)
+                {
+                    return std::invoke(callback, i, t);
+                });
+            }
+            hints[worker].value = hint;
+        });
+    }
+
+}
+
+/*
+ * Run an independent query for every area in the batch, the areas are spread
+ * over a set of worker threads.  The callback is called as callback(index,
+ * tile), where index is the position of the area in the batch, and may be
+ * called concurrently from several threads.
+ *
+ * The plane must not be modified while the batch is running.
+ */
+template <typename F> requires std::invocable<F&, usize, Tile*>
+CENTO_FORCEINLINE void queryBatch(const Plane&                plane,
+                                  const std::span<const Rect> areas,
+                                  F&&                         callback)
+{
+    detail::queryBatch<false>(plane, areas, callback);
+}
+
+template <typename F> requires std::invocable<F&, usize, Tile*>
+CENTO_FORCEINLINE void querySolidBatch(const Plane&                plane,
+                                       const std::span<const Rect> areas,
+                                       F&&                         callback)
+{
+    detail::queryBatch<true>(plane, areas, callback);
+}
+
+namespace detail
+{
+
+    // A horizontal band of the plane along with the tile on the left edge of
+    // the plane holding its bottom row, where the walk of the band begins.
+    struct TileBand
+    {
+        i32   bottom;
+        i32   top;
+        Tile* entry;
+    };
+
+    /*
+     * Cut the plane into bands along the edges between the tiles on its left
+     * edge, every band holding about as many of those rows.
+     */
+    CENTO_FORCEINLINE std::vector<TileBand> tileBands(const Plane& plane, const usize count)
+    {
+        const i32 min = nInfinity + 1;
+        const i32 max = pInfinity - 1;
+
+        std::vector<Tile*> rows;
+        Tile*              hint = plane.hint;
+        for (Tile* t = locate(hint, {min, min}); t != nullptr; t = locate(hint, {min, getTop(t)}))
+        {
+            rows.push_back(t);
+            if (getTop(t) > max) { break; }
+        }
+
+        const usize          n = std::min(count, rows.size());
+        std::vector<TileBand> bands;
+        bands.reserve(n);
+        for (usize b = 0; b < n; ++b)
+        {
+            Tile* const entry = rows[b * rows.size() / n];
+            bands.push_back({.bottom = (b == 0) ? min : getBottom(entry), .top = max, .entry = entry});
+            if (b > 0) { bands[b - 1].top = bands[b].bottom; }
+        }
+
+        return bands;
+    }
+
+}
+
+/*
+ * Call the callback once for every tile of the plane, spreading the work over
+ * a set of worker threads.  The callback may be called concurrently from
+ * several threads and in no particular order.
+ *
+ * The plane is cut into several bands per worker, a tile crossing the cut
+ * between bands is reported by the lowest band it reaches into.  Bands hold
+ * very different numbers of tiles in an uneven layout, so idle workers steal
+ * bands from the busy ones.
+ *
+ * The plane must not be modified while the walk is running.
+ */
+template <typename F> requires std::invocable<F&, Tile*>
+CENTO_FORCEINLINE void parallelForEachTile(const Plane& plane, F&& callback, usize workers = 0)
+{
+    using namespace detail;
+
+    if (workers == 0) { workers = workerCount(); }
+
+    const i32                   min   = nInfinity + 1;
+    const i32                   max   = pInfinity - 1;
+    const std::vector<TileBand> bands = tileBands(plane, workers * 8);
+
+    parallelSteal(bands.size(), workers, [&](usize, usize b)
+    {
+        const TileBand& band = bands[b];
+
+        Tile* hint = band.entry;
+        queryArea<false>(hint, {{min, band.bottom}, {max, band.top}}, [&](Tile* t)
+        {
+            if ((b == 0) || (getBottom(t) >= band.bottom)) { std::invoke(callback, t); }
+        });
+    });
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoBatch_hpp
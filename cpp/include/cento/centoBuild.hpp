@@ -0,0 +1,319 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoBuild_hpp
+#define centoBuild_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoCreate.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoInsert.hpp"
+#include "centoParallel.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    // A tile of a band plane clipped to the rows of the band, once the band is
+    // built the id of each of its tiles is replaced by the index of its piece
+    // and the body kept here instead.
+    struct Piece
+    {
+        Tile* tile;
+        Rect  rect;
+        u64   body;
+        Tile* out = nullptr; // the tile of the final plane this is part of
+    };
+
+    constexpr const usize NoPiece = std::numeric_limits<usize>::max();
+
+    /*
+     * A band being built along with what is known about the pieces on its
+     * bottom and top rows, each indexed by piece: the piece of the band below
+     * each bottom piece is stacked on, the tiles across the cuts from the
+     * corners of the pieces and which top pieces have another stacked on them.
+     * The plans are kept as their lower left corner and index so that sorting
+     * them does not chase through to the plans.
+     */
+    struct BuildBand
+    {
+        i32                                      bottom;
+        i32                                      top;
+        std::vector<std::tuple<i32, i32, usize>> plans;
+        Plane                                    plane;
+        std::vector<Piece>                       pieces;
+        std::vector<usize>                       below;
+        std::vector<Tile*>                       under;
+        std::vector<Tile*>                       over;
+        std::vector<u8>                          continues;
+    };
+
+    CENTO_FORCEINLINE bool canStack(const Piece& lower, const Piece& upper)
+    {
+        return (lower.rect.ll.x == upper.rect.ll.x) &&
+               (lower.rect.ur.x == upper.rect.ur.x) &&
+               (lower.body == upper.body);
+    }
+
+    /*
+     * Place the cuts so that each band starts roughly as many plans, the
+     * bottom edges are sampled rather than all sorted as this runs before any
+     * of the work is spread over the workers.
+     */
+    CENTO_FORCEINLINE std::vector<i32> chooseCuts(const std::span<const TilePlan> plans, const usize bands)
+    {
+        const usize      samples = std::min<usize>(plans.size(), bands * 256);
+        std::vector<i32> ys(samples);
+        for (usize i = 0; i < samples; ++i) { ys[i] = plans[i * plans.size() / samples].rect.ll.y; }
+        std::ranges::sort(ys);
+
+        std::vector<i32> cuts;
+        for (usize b = 1; b < bands; ++b)
+        {
+            const i32 y = ys[b * samples / bands];
+            if (cuts.empty() || (cuts.back() < y)) { cuts.push_back(y); }
+        }
+
+        return cuts;
+    }
+
+    // Insert the pieces of the plans within the band, the id of each piece is
+    // the index of its plan so that pieces of different plans are never
+    // mistaken for each other at the cuts.
+    CENTO_FORCEINLINE void buildBand(BuildBand& band, const std::span<const TilePlan> plans)
+    {
+        // bottom to top then left to right keeps each search for the next
+        // insert close to where the last one finished
+        std::ranges::sort(band.plans);
+
+        createUniverse(band.plane);
+        for (const auto& [y, x, i] : band.plans)
+        {
+            const Rect& r = plans[i].rect;
+            const Rect  clipped{.ll = {r.ll.x, std::max(r.ll.y, band.bottom)},
+                                .ur = {r.ur.x, std::min(r.ur.y, band.top)}};
+
+            [[maybe_unused]] Tile* const t = insertTile(band.plane, {.id = u64(i), .rect = clipped});
+            Expects(t != nullptr);
+        }
+
+        band.pieces.reserve(band.plans.size() * 3);
+
+        const Rect rows{.ll = {nInfinity + 1, std::max(band.bottom, nInfinity + 1)},
+                        .ur = {pInfinity - 1, std::min(band.top, pInfinity - 1)}};
+        query(band.plane, rows, [&](Tile* t)
+        {
+            const Rect r = getRect(t);
+            band.pieces.push_back({.tile = t,
+                                   .rect = {.ll = {r.ll.x, std::max(r.ll.y, band.bottom)},
+                                            .ur = {r.ur.x, std::min(r.ur.y, band.top)}},
+                                   .body = t->id});
+        });
+
+        for (usize i = 0; i < band.pieces.size(); ++i) { setBody(band.pieces[i].tile, i); }
+
+        band.below.assign(band.pieces.size(), NoPiece);
+        band.under.assign(band.pieces.size(), nullptr);
+        band.over.assign(band.pieces.size(), nullptr);
+        band.continues.assign(band.pieces.size(), false);
+    }
+
+    // Pair up the pieces either side of the cut between two bands.
+    CENTO_FORCEINLINE void joinCut(BuildBand& lower, BuildBand& upper)
+    {
+        const i32 cut = upper.bottom;
+
+        std::vector<usize> ups;
+        std::vector<usize> downs;
+        for (usize i = 0; i < upper.pieces.size(); ++i)
+        {
+            if (upper.pieces[i].rect.ll.y == cut) { ups.push_back(i); }
+        }
+        for (usize i = 0; i < lower.pieces.size(); ++i)
+        {
+            if (lower.pieces[i].rect.ur.y == cut) { downs.push_back(i); }
+        }
+
+        // walk along the cut from left to right so each search starts next to
+        // where the previous one finished
+        std::ranges::sort(ups, {}, [&](const usize i) { return upper.pieces[i].rect.ll.x; });
+        std::ranges::sort(downs, {}, [&](const usize i) { return lower.pieces[i].rect.ll.x; });
+
+        Tile* hint = lower.plane.hint;
+        for (const usize i : ups)
+        {
+            const Piece& p     = upper.pieces[i];
+            Tile* const  under = locate(hint, {p.rect.ll.x, cut - 1});
+
+            upper.under[i] = under;
+            if (canStack(lower.pieces[under->id], p))
+            {
+                upper.below[i]             = under->id;
+                lower.continues[under->id] = true;
+            }
+        }
+
+        hint = upper.plane.hint;
+        for (const usize i : downs)
+        {
+            const Piece& p = lower.pieces[i];
+            lower.over[i] = locate(hint, {p.rect.ur.x - 1, cut});
+        }
+    }
+
+}
+
+/*
+ * Build the plane from a set of tile plans which must not overlap, giving the
+ * same tiling as inserting them one at a time.
+ *
+ * The plans are split into horizontal bands holding roughly as many plans
+ * each, every band is then sorted and built as a plane of its own on a
+ * separate thread.  Finally the tiles of the bands are copied into
+ * the plane, stacking the pieces of tiles which cross the cuts between bands
+ * back into one tile and stitching the bands together along the cuts.
+ *
+ * With a single band, as when there is a single worker, the plans are sorted
+ * and inserted straight into the plane instead.
+ *
+ * The plane must be empty, a bands count of zero uses one band per worker.
+ */
+CENTO_FORCEINLINE void buildPlane(Plane& plane, const std::span<const TilePlan> plans, usize bands = 0)
+{
+    using namespace detail;
+
+    if (plans.empty())
+    {
+        createUniverse(plane);
+        return;
+    }
+
+    const usize workers = workerCount();
+    if (bands == 0) { bands = workers; }
+
+    const std::vector<i32> cuts = chooseCuts(plans, bands);
+    if (cuts.empty())
+    {
+        std::vector<std::tuple<i32, i32, usize>> order(plans.size());
+        for (usize i = 0; i < plans.size(); ++i) { order[i] = {plans[i].rect.ll.y, plans[i].rect.ll.x, i}; }
+        std::ranges::sort(order);
+
+        createUniverse(plane);
+        for (const auto& [y, x, i] : order)
+        {
+            [[maybe_unused]] Tile* const t = insertTile(plane, plans[i]);
+            Expects(t != nullptr);
+        }
+        return;
+    }
+
+    std::vector<BuildBand> parts(cuts.size() + 1);
+    for (usize b = 0; b < parts.size(); ++b)
+    {
+        parts[b].bottom = (b == 0)           ? nInfinity : cuts[b - 1];
+        parts[b].top    = (b == cuts.size()) ? pInfinity : cuts[b];
+    }
+    for (usize i = 0; i < plans.size(); ++i)
+    {
+        const Rect& r     = plans[i].rect;
+        const usize first = usize(std::ranges::upper_bound(cuts, r.ll.y) - cuts.begin());
+        const usize last  = usize(std::ranges::upper_bound(cuts, r.ur.y - 1) - cuts.begin());
+        for (usize b = first; b <= last; ++b) { parts[b].plans.emplace_back(r.ll.y, r.ll.x, i); }
+    }
+
+    // 1. Build each band on its own.
+    parallelFor(parts.size(), 1, workers, [&](usize, usize begin, usize end)
+    {
+        for (usize b = begin; b < end; ++b) { buildBand(parts[b], plans); }
+    });
+
+    // 2. Find which pieces stack across each cut.
+    parallelFor(cuts.size(), 1, workers, [&](usize, usize begin, usize end)
+    {
+        for (usize c = begin; c < end; ++c) { joinCut(parts[c], parts[c + 1]); }
+    });
+
+    // 3. Allocate a tile for each stack of pieces, from the bottom band up so
+    //    the piece below has always been given its tile.
+    for (usize b = 0; b < parts.size(); ++b)
+    {
+        for (usize i = 0; i < parts[b].pieces.size(); ++i)
+        {
+            const usize below = parts[b].below[i];
+            parts[b].pieces[i].out = (below == NoPiece) ? get(plane) : parts[b - 1].pieces[below].out;
+        }
+    }
+
+    // 4. Fill in the tiles, the bottom of each stack sets the lower left corner
+    //    with its stitches and the top sets the upper right corner with its
+    //    stitches.  A piece clipped by its band no longer has its corners where
+    //    the band tile does, so those stitches are found again.
+    parallelFor(parts.size(), 1, workers, [&](usize, usize begin, usize end)
+    {
+        for (usize b = begin; b < end; ++b)
+        {
+            const BuildBand& band = parts[b];
+            auto out = [&](const BuildBand& in, const Tile* t) -> Tile*
+            {
+                return t ? in.pieces[t->id].out : nullptr;
+            };
+
+            for (usize i = 0; i < band.pieces.size(); ++i)
+            {
+                const Piece& p    = band.pieces[i];
+                Tile* const  t    = p.out;
+                Tile*        hint = p.tile;
+
+                if (band.below[i] == NoPiece)
+                {
+                    setLeft(t, p.rect.ll.x);
+                    setBottom(t, p.rect.ll.y);
+                    setBody(t, (p.body == Space) ? Space : plans[p.body].id);
+
+                    if (p.rect.ll.x == nInfinity) { bottomLeft(t) = nullptr; }
+                    else if (p.rect.ll.y == getBottom(p.tile)) { bottomLeft(t) = out(band, bottomLeft(p.tile)); }
+                    else { bottomLeft(t) = out(band, locate(hint, {p.rect.ll.x - 1, p.rect.ll.y})); }
+
+                    leftBottom(t) = band.under[i] ? out(parts[b - 1], band.under[i])
+                                                  : out(band, leftBottom(p.tile));
+                }
+
+                if (not band.continues[i])
+                {
+                    setRight(t, p.rect.ur.x);
+                    setTop(t, p.rect.ur.y);
+
+                    if (p.rect.ur.x == pInfinity) { topRight(t) = nullptr; }
+                    else if (p.rect.ur.y == getTop(p.tile)) { topRight(t) = out(band, topRight(p.tile)); }
+                    else { topRight(t) = out(band, locate(hint, {p.rect.ur.x, p.rect.ur.y - 1})); }
+
+                    rightTop(t) = band.over[i] ? out(parts[b + 1], band.over[i])
+                                               : out(band, rightTop(p.tile));
+                }
+            }
+        }
+    });
+
+    plane.hint = parts.front().pieces.front().out;
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoBuild_hpp
@@ -0,0 +1,367 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoCell_hpp
+#define centoCell_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoCreate.hpp"
+#include "centoExplore.hpp"
+#include "centoIndex.hpp"
+#include "centoInsert.hpp"
+#include "centoParallel.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+struct Cell;
+
+/*
+ * A placement of a cell within another, the geometry of the child cell is
+ * seen translated by the origin.  A placement may also be an array of columns
+ * by rows copies of the cell spaced out by the pitch, the copy in column c and
+ * row r sits at origin + (c * pitch.x, r * pitch.y).
+ */
+struct Placement
+{
+    const Cell* cell    = nullptr;
+    Point       origin  = {};
+    i32         columns = 1;
+    i32         rows    = 1;
+    Point       pitch   = {};
+};
+
+/*
+ * A cell of a hierarchical layout, the tiles drawn in the cell itself are held
+ * in a plane of its own while the cells placed in it are only referenced.  A
+ * cell placed many times costs its geometry once.  The extents of the
+ * placements are kept in an index so a query only visits those it overlaps.
+ *
+ * Cells are built from the bottom up, the bounds of a cell cover its own
+ * tiles and those of its children as they were when they were placed.  The
+ * bounds of its own tiles are kept apart so that moving a placement off the
+ * edge of the bounds can work them out again from the rest, and they shrink
+ * back as well as grow.
+ */
+struct Cell
+{
+    Plane                  plane;
+    std::vector<Placement> placements;
+    PlacementIndex         index;
+    Rect                   own    = {{pInfinity, pInfinity}, {nInfinity, nInfinity}};
+    Rect                   bounds = {{pInfinity, pInfinity}, {nInfinity, nInfinity}};
+};
+
+CENTO_FORCEINLINE bool isEmpty(const Cell& cell) noexcept
+{
+    return cell.bounds.ll.x > cell.bounds.ur.x;
+}
+
+CENTO_FORCEINLINE Tile* createUniverse(Cell& cell)
+{
+    createUniverse(cell.index);
+    return createUniverse(cell.plane);
+}
+
+CENTO_FORCEINLINE Tile* insertTile(Cell& cell, const TilePlan& plan)
+{
+    Tile* const t = insertTile(cell.plane, plan);
+    if (t != nullptr)
+    {
+        cell.own    = boundingBox(cell.own, plan.rect);
+        cell.bounds = boundingBox(cell.bounds, plan.rect);
+    }
+
+    return t;
+}
+
+namespace detail
+{
+
+    CENTO_FORCEINLINE Point negate(const Point& p) noexcept
+    {
+        return {.x = -p.x, .y = -p.y};
+    }
+
+    CENTO_FORCEINLINE i64 floorDiv(const i64 n, const i64 d) noexcept
+    {
+        return (n / d) - (((n % d) != 0) && ((n < 0) != (d < 0)) ? 1 : 0);
+    }
+
+    /*
+     * The copies of an array along one axis which overlap [lo, hi), given the
+     * copies span [first, last) from the origin and are pitch apart.  Returns
+     * the first and one past the last overlapping index, a single copy may have
+     * any pitch.
+     */
+    CENTO_FORCEINLINE std::pair<i32, i32> overlapping(const i64 first,
+                                                      const i64 last,
+                                                      const i32 count,
+                                                      const i32 pitch,
+                                                      const i64 lo,
+                                                      const i64 hi) noexcept
+    {
+        if (count == 1) { return {0, ((first < hi) && (lo < last)) ? 1 : 0}; }
+
+        // copy i overlaps when first + i * pitch < hi and lo < last + i * pitch
+        const i64 begin = floorDiv(lo - last, pitch) + 1;
+        const i64 end   = floorDiv(hi - first - 1, pitch) + 1;
+
+        return {i32(std::clamp<i64>(begin, 0, count)), i32(std::clamp<i64>(end, 0, count))};
+    }
+
+    // The area covered by every copy of a placement.
+    CENTO_FORCEINLINE Rect extent(const Placement& p)
+    {
+        const Rect& b = p.cell->bounds;
+        const Point far{.x = p.origin.x + (p.columns - 1) * p.pitch.x,
+                        .y = p.origin.y + (p.rows - 1) * p.pitch.y};
+
+        return boundingBox(translate(b, p.origin), translate(b, far));
+    }
+
+    // Whether the rect, which lies within the bounds, reaches any edge of them.
+    CENTO_FORCEINLINE bool onEdge(const Rect& r, const Rect& bounds) noexcept
+    {
+        return (r.ll.x == bounds.ll.x) || (r.ll.y == bounds.ll.y) ||
+               (r.ur.x == bounds.ur.x) || (r.ur.y == bounds.ur.y);
+    }
+
+    // The bounds of the cell worked out from its own tiles and placements.
+    CENTO_FORCEINLINE Rect boundsOf(const Cell& cell)
+    {
+        Rect bounds = cell.own;
+        for (const Placement& p : cell.placements)
+        {
+            if (not isEmpty(*p.cell)) { bounds = boundingBox(bounds, extent(p)); }
+        }
+
+        return bounds;
+    }
+
+}
+
+CENTO_FORCEINLINE void place(Cell& parent, const Placement& placement)
+{
+    Expects(&parent != placement.cell);
+    Expects((placement.columns > 0) && (placement.rows > 0));
+    Expects((placement.columns == 1) || (placement.pitch.x > 0));
+    Expects((placement.rows == 1) || (placement.pitch.y > 0));
+
+    parent.placements.push_back(placement);
+    if (isEmpty(*placement.cell)) { return; }
+
+    const Rect extent = detail::extent(placement);
+    insertBox(parent.index, u32(parent.placements.size() - 1), extent);
+    parent.bounds = boundingBox(parent.bounds, extent);
+}
+
+CENTO_FORCEINLINE void place(Cell& parent, const Cell& child, const Point& origin)
+{
+    place(parent, {.cell = &child, .origin = origin});
+}
+
+/*
+ * Place an array of columns by rows copies of the child, a query only ever
+ * visits the copies which overlap it so an array costs the same however large
+ * it is.
+ */
+CENTO_FORCEINLINE void place(Cell&        parent,
+                             const Cell&  child,
+                             const Point& origin,
+                             const i32    columns,
+                             const i32    rows,
+                             const Point& pitch)
+{
+    place(parent, {.cell = &child, .origin = origin, .columns = columns, .rows = rows, .pitch = pitch});
+}
+
+/*
+ * Move the placement at position i of the parent to a new origin.  The bounds
+ * of the parent are only worked out again from every placement when the one
+ * moved was on their edge, otherwise they just take in where it went.
+ */
+CENTO_FORCEINLINE void movePlacement(Cell& parent, const usize i, const Point& origin)
+{
+    Placement& p = parent.placements[i];
+    if (isEmpty(*p.cell))
+    {
+        p.origin = origin;
+        return;
+    }
+
+    const Rect before = detail::extent(p);
+    p.origin          = origin;
+
+    const Rect extent = detail::extent(p);
+    moveBox(parent.index, u32(i), extent);
+    parent.bounds = detail::onEdge(before, parent.bounds) ? detail::boundsOf(parent)
+                                                          : boundingBox(parent.bounds, extent);
+}
+
+namespace detail
+{
+
+    template <typename F> requires std::invocable<F&, Tile*, const Point&>
+    void queryCell(const Cell& cell, const Rect& area, const Point& offset, F& callback)
+    {
+        if (not overlaps(cell.bounds, area)) { return; }
+
+        querySolid(cell.plane, area, [&](Tile* t) { std::invoke(callback, t, offset); });
+
+        queryBoxes(cell.index, area, [&](const u32 i)
+        {
+            const Placement& p     = cell.placements[i];
+            const Cell&      child = *p.cell;
+
+            // the copies of an array overlapping the area are worked out
+            // rather than searched for, a single placement is a 1 x 1 array
+            const Rect b        = translate(child.bounds, p.origin);
+            const auto [c0, c1] = overlapping(b.ll.x, b.ur.x, p.columns, p.pitch.x, area.ll.x, area.ur.x);
+            const auto [r0, r1] = overlapping(b.ll.y, b.ur.y, p.rows, p.pitch.y, area.ll.y, area.ur.y);
+
+            for (i32 r = r0; r < r1; ++r)
+            {
+                for (i32 c = c0; c < c1; ++c)
+                {
+                    const Point at{.x = p.origin.x + c * p.pitch.x, .y = p.origin.y + r * p.pitch.y};
+                    queryCell(child, translate(area, negate(at)), translate(offset, at), callback);
+                }
+            }
+        });
+    }
+
+}
+
+/*
+ * Enumerate the solid tiles of the cell and every cell placed within it which
+ * fall in the area, descending into each placement by translating the area
+ * into the space of the child.  The callback is called as callback(tile,
+ * offset) where offset moves the tile from its own cell into the space of the
+ * queried one.  A tile of a cell placed several times is reported once for
+ * each placement overlapping the area.
+ */
+template <typename F> requires std::invocable<F&, Tile*, const Point&>
+CENTO_FORCEINLINE void queryCell(const Cell& cell, const Rect& area, F&& callback)
+{
+    detail::queryCell(cell, area, Point{0, 0}, callback);
+}
+
+/*
+ * Flatten the cell into the solid tiles of the whole hierarchy, translated
+ * into the space of the cell.
+ */
+CENTO_FORCEINLINE std::vector<TilePlan> flatten(const Cell& cell)
+{
+    std::vector<TilePlan> plans;
+    if (isEmpty(cell)) { return plans; }
+
+    queryCell(cell, cell.bounds, [&](Tile* t, const Point& offset)
+    {
+        plans.push_back({.id = t->id, .rect = translate(getRect(t), offset)});
+    });
+
+    return plans;
+}
+
+namespace detail
+{
+
+    using FlatCells = std::unordered_map<const Cell*, std::vector<TilePlan>>;
+
+    /*
+     * The flattened tiles of a cell, each distinct child is flattened once
+     * and then only copied.  The size of the output is known before anything
+     * is copied so it is made once and each copy of a placement is written to
+     * a slice of its own by whichever worker takes it.
+     */
+    inline const std::vector<TilePlan>& flatten(const Cell& cell, const usize workers, FlatCells& done)
+    {
+        if (const auto it = done.find(&cell); it != done.end()) { return it->second; }
+
+        std::vector<TilePlan> own;
+        if (not isEmpty(cell))
+        {
+            querySolid(cell.plane, cell.bounds, [&](Tile* t) { own.push_back({.id = t->id, .rect = getRect(t)}); });
+        }
+
+        // the copies of placement p are numbered from first[p] and written
+        // from base[p], children are flattened before any copying starts
+        std::vector<const std::vector<TilePlan>*> shapes;
+        std::vector<usize>                        first = {0};
+        std::vector<usize>                        base;
+        usize                                     size = own.size();
+        for (const Placement& p : cell.placements)
+        {
+            const std::vector<TilePlan>& shape  = flatten(*p.cell, workers, done);
+            const usize                  copies = usize(p.columns) * usize(p.rows);
+
+            shapes.push_back(&shape);
+            first.push_back(first.back() + copies);
+            base.push_back(size);
+            size += copies * shape.size();
+        }
+
+        std::vector<TilePlan> plans(size);
+        std::ranges::copy(own, plans.begin());
+
+        parallelFor(first.back(), 256, workers, [&](usize, const usize begin, const usize end)
+        {
+            usize p = usize(std::ranges::upper_bound(first, begin) - first.begin()) - 1;
+            for (usize j = begin; j < end; ++j)
+            {
+                while (j >= first[p + 1]) { ++p; }
+
+                const Placement&             placement = cell.placements[p];
+                const std::vector<TilePlan>& shape     = *shapes[p];
+                const usize                  k         = j - first[p];
+                const Point at{.x = placement.origin.x + i32(k % usize(placement.columns)) * placement.pitch.x,
+                               .y = placement.origin.y + i32(k / usize(placement.columns)) * placement.pitch.y};
+
+                TilePlan* out = plans.data() + base[p] + k * shape.size();
+                for (const TilePlan& plan : shape)
+                {
+                    *out++ = {.id = plan.id, .rect = translate(plan.rect, at)};
+                }
+            }
+        });
+
+        return done.emplace(&cell, std::move(plans)).first->second;
+    }
+
+}
+
+/*
+ * Flatten the cell as flatten does, but make the output once and spread the
+ * copying of the placements over a set of workers.  Suited to a large top
+ * cell holding many instances of a few small ones, each distinct cell is
+ * only flattened once however often it is placed.
+ */
+CENTO_FORCEINLINE std::vector<TilePlan> parallelFlatten(const Cell& cell, usize workers = 0)
+{
+    if (workers == 0) { workers = detail::workerCount(); }
+
+    detail::FlatCells done;
+    detail::flatten(cell, workers, done);
+
+    return std::move(done.at(&cell));
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoCell_hpp
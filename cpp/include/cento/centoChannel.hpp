@@ -0,0 +1,302 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoChannel_hpp
+#define centoChannel_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoExplore.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    // A rect of space being grown upwards from its bottom edge, the tile is
+    // the space tile it has reached whose top is the top of the rect.
+    struct Growth
+    {
+        const Tile* tile   = nullptr;
+        i32         left   = 0;
+        i32         right  = 0;
+        i32         bottom = 0;
+    };
+
+    // The tiles touching the top of the tile within [left, right).
+    CENTO_FORCEINLINE std::vector<Tile*> tilesAbove(const Tile* tile, const i32 left, const i32 right)
+    {
+        std::vector<Tile*> above;
+        topTiles(tile, [&](Tile* t)
+        {
+            if ((getLeft(t) < right) && (getRight(t) > left)) { above.push_back(t); }
+        });
+
+        return above;
+    }
+
+    // The tiles touching the bottom of the tile within [left, right).
+    CENTO_FORCEINLINE std::vector<Tile*> tilesBelow(const Tile* tile, const i32 left, const i32 right)
+    {
+        std::vector<Tile*> below;
+        bottomTiles(tile, [&](Tile* t)
+        {
+            if ((getLeft(t) < right) && (getRight(t) > left)) { below.push_back(t); }
+        });
+
+        return below;
+    }
+
+    /*
+     * The highest value raised over each part of a line cut at the edges xs,
+     * a segment tree keeping for each node the highest value anywhere beneath
+     * it and the highest raised over the whole of it.
+     */
+    struct Skyline
+    {
+        std::vector<i32> xs;
+        std::vector<i32> below;
+        std::vector<i32> over;
+    };
+
+    CENTO_FORCEINLINE Skyline skyline(std::vector<i32> xs, const i32 floor)
+    {
+        const usize nodes = 4 * std::max<usize>(xs.size(), 1);
+
+        return {.xs = std::move(xs), .below = std::vector<i32>(nodes, floor), .over = std::vector<i32>(nodes, floor)};
+    }
+
+    inline void raise(Skyline& sky, const usize node, const usize lo, const usize hi, const usize l, const usize r, const i32 v)
+    {
+        if ((r <= lo) || (hi <= l)) { return; }
+
+        sky.below[node] = std::max(sky.below[node], v);
+        if ((l <= lo) && (hi <= r))
+        {
+            sky.over[node] = std::max(sky.over[node], v);
+            return;
+        }
+
+        const usize mid = (lo + hi) / 2;
+        raise(sky, 2 * node + 1, lo, mid, l, r, v);
+        raise(sky, 2 * node + 2, mid, hi, l, r, v);
+    }
+
+    inline i32 highest(const Skyline& sky, const usize node, const usize lo, const usize hi, const usize l, const usize r)
+    {
+        if ((l <= lo) && (hi <= r)) { return sky.below[node]; }
+
+        const usize mid  = (lo + hi) / 2;
+        i32         high = sky.over[node];
+        if (l < mid) { high = std::max(high, highest(sky, 2 * node + 1, lo, mid, l, r)); }
+        if (mid < r) { high = std::max(high, highest(sky, 2 * node + 2, mid, hi, l, r)); }
+
+        return high;
+    }
+
+    CENTO_FORCEINLINE usize edgeIndex(const Skyline& sky, const i32 x)
+    {
+        return usize(std::ranges::lower_bound(sky.xs, x) - sky.xs.begin());
+    }
+
+    // Raise [left, right) to at least v.
+    CENTO_FORCEINLINE void raise(Skyline& sky, const i32 left, const i32 right, const i32 v)
+    {
+        raise(sky, 0, 0, sky.xs.size() - 1, edgeIndex(sky, left), edgeIndex(sky, right), v);
+    }
+
+    // The highest value over [left, right).
+    CENTO_FORCEINLINE i32 highest(const Skyline& sky, const i32 left, const i32 right)
+    {
+        return highest(sky, 0, 0, sky.xs.size() - 1, edgeIndex(sky, left), edgeIndex(sky, right));
+    }
+
+}
+
+/*
+ * The maximal empty rects within the region at least minW wide and minH tall,
+ * those which hold no solid tile and cannot grow any way without taking one in
+ * or leaving the region.
+ *
+ * The bottom of every such rect lies along the bottom of a space tile and its
+ * width within that of the tile, since space is kept as maximal horizontal
+ * strips.  So each space tile is grown upwards through the stitches along its
+ * top, the rect splitting wherever solid tiles above cut across it and being
+ * reported where it can grow no higher.  Rects which could also grow down are
+ * left to the space tile beneath them.  The time taken is proportional to the
+ * rects found and the tiles walked to find them.
+ */
+CENTO_FORCEINLINE std::vector<Rect> maximalEmptyRects(const Plane& plane, const Rect& region, const i32 minW, const i32 minH)
+{
+    Expects((minW > 0) && (minH > 0));
+
+    std::vector<Rect> found;
+
+    auto blockedBelow = [&](const Tile* start, const i32 left, const i32 right, const i32 bottom)
+    {
+        if (bottom <= region.ll.y) { return true; }
+
+        const std::vector<Tile*> below = detail::tilesBelow(start, left, right);
+        return std::ranges::any_of(below, [](const Tile* t) { return isSolid(t); });
+    };
+
+    std::vector<detail::Growth> pending;
+    query(plane, region, [&](Tile* t)
+    {
+        if (isSolid(t)) { return; }
+
+        const i32 left  = std::max(getLeft(t), region.ll.x);
+        const i32 right = std::min(getRight(t), region.ur.x);
+        if (right - left < minW) { return; }
+
+        const i32 bottom = std::max(getBottom(t), region.ll.y);
+        pending.push_back({.tile = t, .left = left, .right = right, .bottom = bottom});
+
+        while (not pending.empty())
+        {
+            const detail::Growth g = pending.back();
+            pending.pop_back();
+
+            const i32 top = std::min(getTop(g.tile), region.ur.y);
+            if (top < region.ur.y)
+            {
+                const std::vector<Tile*> above = detail::tilesAbove(g.tile, g.left, g.right);
+
+                // space right across the rect, it grows on through the tile
+                if ((above.size() == 1) && isSpace(above.front()))
+                {
+                    pending.push_back({.tile = above.front(), .left = g.left, .right = g.right, .bottom = g.bottom});
+                    continue;
+                }
+
+                // the rect splits into the pieces between the solid tiles
+                for (const Tile* a : above)
+                {
+                    if (isSolid(a)) { continue; }
+
+                    const i32 l = std::max(g.left, getLeft(a));
+                    const i32 r = std::min(g.right, getRight(a));
+                    if (r - l >= minW) { pending.push_back({.tile = a, .left = l, .right = r, .bottom = g.bottom}); }
+                }
+            }
+
+            if ((top - g.bottom >= minH) && blockedBelow(t, g.left, g.right, g.bottom))
+            {
+                found.push_back({{g.left, g.bottom}, {g.right, top}});
+            }
+        }
+    });
+
+    return found;
+}
+
+/*
+ * The horizontal routing channels within the region at least minHeight tall,
+ * each strip of space grown up and down across its whole width for as far as
+ * it stays empty.  There is one channel for each strip of space, those strips
+ * of the same width stacked on each other giving the same channel once.
+ *
+ * A strip grows down to the highest top of the solid tiles beneath it within
+ * its width, so one sweep up the region raising a skyline over the tops of
+ * the solid tiles as it passes them finds the bottom of every channel, and a
+ * second sweep down over their bottoms finds the tops.  The time taken is
+ * proportional to the tiles in the region and the log of their number.
+ */
+CENTO_FORCEINLINE std::vector<Rect> findChannels(const Plane& plane, const Rect& region, const i32 minHeight)
+{
+    Expects(minHeight > 0);
+
+    // the strips of space and the solid tiles, cut down to the region
+    std::vector<Rect> strips;
+    std::vector<Rect> solids;
+    std::vector<i32>  xs;
+    query(plane, region, [&](Tile* t)
+    {
+        const Rect r = intersection(getRect(t), region);
+        (isSpace(t) ? strips : solids).push_back(r);
+        xs.push_back(r.ll.x);
+        xs.push_back(r.ur.x);
+    });
+    if (strips.empty()) { return {}; }
+
+    std::ranges::sort(xs);
+    xs.erase(std::ranges::unique(xs).begin(), xs.end());
+
+    std::vector<usize> order(strips.size());
+    std::iota(order.begin(), order.end(), usize(0));
+
+    // going up, a channel stacked on an identical strip is left to the lowest
+    std::vector<i32>  bottoms(strips.size());
+    std::vector<bool> kept(strips.size());
+    {
+        std::ranges::sort(order, {}, [&](const usize i) { return strips[i].ll.y; });
+        std::ranges::sort(solids, {}, [](const Rect& r) { return r.ur.y; });
+
+        detail::Skyline floor = detail::skyline(xs, region.ll.y);
+        std::set<std::tuple<i32, i32, i32>> seen;
+
+        usize next = 0;
+        for (const usize i : order)
+        {
+            const Rect& s = strips[i];
+            for (; (next < solids.size()) && (solids[next].ur.y <= s.ll.y); ++next)
+            {
+                detail::raise(floor, solids[next].ll.x, solids[next].ur.x, solids[next].ur.y);
+            }
+
+            bottoms[i] = detail::highest(floor, s.ll.x, s.ur.x);
+            kept[i]    = seen.insert({s.ll.x, s.ur.x, bottoms[i]}).second;
+        }
+    }
+
+    // going down, with the heights turned around so the lowest is the highest
+    std::vector<i32> tops(strips.size());
+    {
+        std::ranges::sort(order, std::greater<>{}, [&](const usize i) { return strips[i].ur.y; });
+        std::ranges::sort(solids, std::greater<>{}, [](const Rect& r) { return r.ll.y; });
+
+        detail::Skyline ceiling = detail::skyline(xs, -region.ur.y);
+
+        usize next = 0;
+        for (const usize i : order)
+        {
+            const Rect& s = strips[i];
+            for (; (next < solids.size()) && (solids[next].ll.y >= s.ur.y); ++next)
+            {
+                detail::raise(ceiling, solids[next].ll.x, solids[next].ur.x, -solids[next].ll.y);
+            }
+
+            tops[i] = -detail::highest(ceiling, s.ll.x, s.ur.x);
+        }
+    }
+
+    std::vector<Rect> channels;
+    for (usize i = 0; i < strips.size(); ++i)
+    {
+        if (kept[i] && (tops[i] - bottoms[i] >= minHeight))
+        {
+            channels.push_back({{strips[i].ll.x, bottoms[i]}, {strips[i].ur.x, tops[i]}});
+        }
+    }
+
+    return channels;
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoChannel_hpp
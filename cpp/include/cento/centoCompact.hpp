@@ -0,0 +1,389 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoCompact_hpp
+#define centoCompact_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoBuild.hpp"
+#include "centoDirection.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoInsert.hpp"
+#include "centoPlane.hpp"
+#include "centoRemove.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    // Swap x and y, so that compacting down is compacting left.
+    CENTO_FORCEINLINE Rect transpose(const Rect& r) noexcept
+    {
+        return {.ll = {.x = r.ll.y, .y = r.ll.x}, .ur = {.x = r.ur.y, .y = r.ur.x}};
+    }
+
+    // A solid tile which must keep at least gap between its right edge and
+    // the left edge of another, or once turned onto shapes the least distance
+    // from the start of one shape to the start of another.
+    struct Constraint
+    {
+        u32 from = 0;
+        u32 to   = 0;
+        i32 gap  = 0;
+    };
+
+    /*
+     * The constraints between the solid tiles of a plane whose ids are their
+     * own indices, one for each pair which can see each other horizontally.
+     * Space is kept as maximal horizontal strips so a space tile to the right
+     * of a solid tile ends at solid tiles, which are then the ones it sees.
+     */
+    template <typename F>
+    CENTO_FORCEINLINE std::vector<Constraint> constraints(const Plane& plane, F& spacing, const std::vector<u64>& ids)
+    {
+        std::vector<Constraint> edges;
+        auto add = [&](const Tile* from, const Tile* to)
+        {
+            const i32 gap = i32(std::invoke(spacing, ids[from->id], ids[to->id]));
+            Expects(gap >= 0);
+
+            edges.push_back({.from = u32(from->id), .to = u32(to->id), .gap = gap});
+        };
+
+        queryAll(plane, [&](Tile* t)
+        {
+            if (isSpace(t)) { return; }
+
+            rightTiles(t, [&](Tile* n)
+            {
+                if (isSolid(n))
+                {
+                    add(t, n);
+                    return;
+                }
+
+                rightTiles(n, [&](Tile* m)
+                {
+                    if (isSolid(m) && (getBottom(m) < getTop(t)) && (getTop(m) > getBottom(t))) { add(t, m); }
+                });
+            });
+        });
+
+        return edges;
+    }
+
+    /*
+     * Number the shapes of the tiles, each shape being the tiles of one id
+     * which are joined edge to edge.  Returns the shape of each tile and sets
+     * count to the number of shapes.
+     */
+    CENTO_FORCEINLINE std::vector<u32> shapes(const std::vector<Tile*>& tiles, u32& count)
+    {
+        std::unordered_map<const Tile*, u32> index;
+        for (u32 i = 0; i < tiles.size(); ++i) { index.emplace(tiles[i], i); }
+
+        std::vector<u32> parent(tiles.size());
+        std::iota(parent.begin(), parent.end(), 0);
+        auto root = [&](u32 i)
+        {
+            while (parent[i] != i) { i = parent[i] = parent[parent[i]]; }
+            return i;
+        };
+
+        for (u32 i = 0; i < tiles.size(); ++i)
+        {
+            auto join = [&](Tile* n) { parent[root(index.at(n))] = root(i); };
+            joinedTiles(tiles[i], join);
+        }
+
+        std::vector<u32> shape(tiles.size());
+        std::vector<u32> number(tiles.size(), u32(-1));
+        count = 0;
+        for (u32 i = 0; i < tiles.size(); ++i)
+        {
+            u32& n = number[root(i)];
+            if (n == u32(-1)) { n = count++; }
+            shape[i] = n;
+        }
+
+        return shape;
+    }
+
+    /*
+     * The strongly connected components of the graph of count nodes whose
+     * edges from node g are edges[order[k]] for offsets[g] <= k < offsets[g + 1],
+     * found by Tarjan's algorithm without recursion.  Returns the nodes of
+     * each component, the components in topological order.
+     */
+    CENTO_FORCEINLINE std::vector<std::vector<u32>> components(const u32                      count,
+                                                               const std::vector<u32>&        offsets,
+                                                               const std::vector<u32>&        order,
+                                                               const std::vector<Constraint>& edges)
+    {
+        constexpr u32 unseen = u32(-1);
+
+        std::vector<u32>  index(count, unseen);
+        std::vector<u32>  low(count, 0);
+        std::vector<bool> held(count, false);
+        std::vector<u32>  stack;
+        u32               next = 0;
+
+        std::vector<std::vector<u32>> found;
+        std::vector<std::pair<u32, u32>> calls;
+        auto enter = [&](const u32 v)
+        {
+            index[v] = low[v] = next++;
+            stack.push_back(v);
+            held[v] = true;
+            calls.push_back({v, offsets[v]});
+        };
+
+        for (u32 root = 0; root < count; ++root)
+        {
+            if (index[root] != unseen) { continue; }
+
+            enter(root);
+            while (not calls.empty())
+            {
+                const u32 v = calls.back().first;
+                if (u32& k = calls.back().second; k < offsets[v + 1])
+                {
+                    const u32 w = edges[order[k++]].to;
+                    if (index[w] == unseen) { enter(w); }
+                    else if (held[w]) { low[v] = std::min(low[v], index[w]); }
+                    continue;
+                }
+
+                calls.pop_back();
+                if (not calls.empty())
+                {
+                    const u32 parent = calls.back().first;
+                    low[parent]      = std::min(low[parent], low[v]);
+                }
+                if (low[v] != index[v]) { continue; }
+
+                std::vector<u32>& members = found.emplace_back();
+                u32               w       = 0;
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    held[w] = false;
+                    members.push_back(w);
+                }
+                while (w != v);
+            }
+        }
+
+        // a component is finished only after all of those it reaches
+        std::ranges::reverse(found);
+
+        return found;
+    }
+
+}
+
+/*
+ * Compact the solid tiles of the plane along the axis, moving each one as far
+ * left (Axis::Horizontal) or down (Axis::Vertical) as it can go while keeping
+ * at least spacing(a, b) between a tile of id a and each tile of id b it faces
+ * further along the axis.  Nothing moves past the lowest edge of the layout.
+ *
+ * Tiles of one id joined edge to edge are a single shape, cut into tiles only
+ * by the plane, and move together as one without spacing between them.
+ *
+ * A constraint is made between each pair of tiles of different shapes which
+ * see each other along the axis, found from the neighbours of the tiles, and
+ * the new positions of the shapes are the longest paths through those
+ * constraints.  A shape may reach around another, making a cycle of
+ * constraints, so the shapes are first gathered into their strongly connected
+ * components.  The components are placed in topological order, and only the
+ * shapes within a cycle are settled by going over the constraints among them
+ * again until nothing moves.  Each tile which moves is removed and inserted
+ * again, so the pointers to those tiles are no longer valid.  Returns the
+ * number of tiles moved.
+ */
+template <typename F> requires std::invocable<F&, u64, u64>
+CENTO_FORCEINLINE usize compact(Plane& plane, const Axis axis, F&& spacing)
+{
+    const bool horizontal = (axis == Axis::Horizontal);
+
+    std::vector<Tile*>    tiles;
+    std::vector<u64>      ids;
+    std::vector<TilePlan> nodes;
+    queryAll(plane, [&](Tile* t)
+    {
+        if (isSpace(t)) { return; }
+
+        const Rect r = horizontal ? getRect(t) : detail::transpose(getRect(t));
+        Expects((r.ll.x != nInfinity) && (r.ur.x != pInfinity));
+
+        nodes.push_back({.id = nodes.size(), .rect = r});
+        tiles.push_back(t);
+        ids.push_back(t->id);
+    });
+    if (nodes.empty()) { return 0; }
+
+    // 1. Find the constraints in a plane of the tiles turned onto the axis,
+    //    leaving out those within a shape.
+    Plane scratch;
+    buildPlane(scratch, nodes);
+
+    u32                             groups = 0;
+    const std::vector<u32>          shape  = detail::shapes(tiles, groups);
+    std::vector<detail::Constraint> edges  = detail::constraints(scratch, spacing, ids);
+    std::erase_if(edges, [&](const detail::Constraint& e) { return shape[e.from] == shape[e.to]; });
+
+    // 2. Turn them into constraints on the starts of the shapes, each tile
+    //    keeping its offset from the start of its shape.
+    const usize      count = nodes.size();
+    std::vector<i32> first(groups, pInfinity);
+    for (usize i = 0; i < count; ++i) { first[shape[i]] = std::min(first[shape[i]], nodes[i].rect.ll.x); }
+
+    auto offset = [&](const u32 i) { return nodes[i].rect.ll.x - first[shape[i]]; };
+
+    std::vector<detail::Constraint> starts;
+    std::vector<detail::Constraint> asPlaced;
+    for (const detail::Constraint& e : edges)
+    {
+        const Rect& a      = nodes[e.from].rect;
+        const Rect& b      = nodes[e.to].rect;
+        auto        turned = [&](const i32 gap)
+        {
+            return detail::Constraint{.from = shape[e.from], .to = shape[e.to], .gap = offset(e.from) + (a.ur.x - a.ll.x) + gap - offset(e.to)};
+        };
+
+        starts.push_back(turned(e.gap));
+        asPlaced.push_back(turned(std::min(e.gap, b.ll.x - a.ur.x)));
+    }
+
+    // 3. Sort them by the shape they start from.
+    std::vector<u32> offsets(groups + 1, 0);
+    std::vector<u32> order(edges.size());
+    for (const detail::Constraint& e : edges) { ++offsets[shape[e.from] + 1]; }
+    for (usize g = 0; g < groups; ++g) { offsets[g + 1] += offsets[g]; }
+    {
+        std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+        for (u32 e = 0; e < edges.size(); ++e) { order[fill[shape[edges[e].from]]++] = e; }
+    }
+
+    // 4. Place the shapes a component at a time in topological order, each
+    //    as close to the start as the constraints into it allow.  The shapes
+    //    of a cycle go over the constraints among them again until none moves
+    //    a shape.  A cycle can only fail to be met where a shape already sits
+    //    closer than its spacing to another reaching around it, so then the
+    //    tiles of that cycle closer than their spacing keep the distance they
+    //    have.
+    const std::vector<std::vector<u32>> components = detail::components(groups, offsets, order, starts);
+
+    std::vector<u32> component(groups);
+    for (u32 c = 0; c < components.size(); ++c)
+    {
+        for (const u32 g : components[c]) { component[g] = c; }
+    }
+
+    i32 start = pInfinity;
+    for (const TilePlan& n : nodes) { start = std::min(start, n.rect.ll.x); }
+
+    std::vector<i32> placed(groups, start);
+    std::vector<i32> entered;
+    for (u32 c = 0; c < components.size(); ++c)
+    {
+        const std::vector<u32>& members = components[c];
+
+        auto settle = [&](const std::vector<detail::Constraint>& gaps)
+        {
+            for (usize round = 0; round <= members.size(); ++round)
+            {
+                bool moved = false;
+                for (const u32 g : members)
+                {
+                    for (u32 k = offsets[g]; k < offsets[g + 1]; ++k)
+                    {
+                        const detail::Constraint& e = gaps[order[k]];
+                        if ((component[e.to] == c) && (placed[g] + e.gap > placed[e.to]))
+                        {
+                            placed[e.to] = placed[g] + e.gap;
+                            moved        = true;
+                        }
+                    }
+                }
+                if (not moved) { return true; }
+            }
+
+            return false;
+        };
+
+        if (members.size() > 1)
+        {
+            entered.clear();
+            for (const u32 g : members) { entered.push_back(placed[g]); }
+
+            if (not settle(starts))
+            {
+                for (usize i = 0; i < members.size(); ++i) { placed[members[i]] = entered[i]; }
+
+                [[maybe_unused]] const bool met = settle(asPlaced);
+                Ensures(met);
+            }
+        }
+
+        for (const u32 g : members)
+        {
+            for (u32 k = offsets[g]; k < offsets[g + 1]; ++k)
+            {
+                const detail::Constraint& e = starts[order[k]];
+                if (component[e.to] != c) { placed[e.to] = std::max(placed[e.to], placed[g] + e.gap); }
+            }
+        }
+    }
+
+    // 5. Move the tiles, all of those moving are lifted out first so none of
+    //    them lands on one yet to move.
+    std::vector<u32> moving;
+    for (u32 i = 0; i < count; ++i)
+    {
+        if (placed[shape[i]] != first[shape[i]]) { moving.push_back(i); }
+    }
+
+    // removing a tile joins up the tiles of its id about it, which are of the
+    // same shape and so moving too, so each is found again by where it was
+    for (const u32 i : moving)
+    {
+        const Rect r = nodes[i].rect;
+        if (Tile* const t = findTileAt(plane, (horizontal ? r : detail::transpose(r)).ll); isSolid(t)) { removeTile(plane, t); }
+    }
+    for (const u32 i : moving)
+    {
+        Rect r = nodes[i].rect;
+        r.ur.x = placed[shape[i]] + offset(i) + (r.ur.x - r.ll.x);
+        r.ll.x = placed[shape[i]] + offset(i);
+
+        [[maybe_unused]] Tile* const t = insertTile(plane, {.id = ids[i], .rect = horizontal ? r : detail::transpose(r)});
+        Ensures(t != nullptr);
+    }
+
+    return moving.size();
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoCompact_hpp
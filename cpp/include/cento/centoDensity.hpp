@@ -0,0 +1,194 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoDensity_hpp
+#define centoDensity_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoExplore.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <gsl/assert>
+#include <vector>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * The solid area covered in each window of a sliding window sweep over an
+ * extent, window (c, r) has its lower left corner at
+ * extent.ll + (c * step, r * step) and is window units wide and high.
+ *
+ * The areas are stored row major.
+ */
+struct DensityMap
+{
+    Rect             extent;
+    i32              window;
+    i32              step;
+    i32              columns;
+    i32              rows;
+    std::vector<i64> area;
+};
+
+CENTO_FORCEINLINE i64 coverage(const DensityMap& map, const i32 column, const i32 row)
+{
+    return map.area[usize(row) * usize(map.columns) + usize(column)];
+}
+
+CENTO_FORCEINLINE f64 density(const DensityMap& map, const i32 column, const i32 row)
+{
+    const f64 size = f64(map.window) * f64(map.window);
+    return f64(coverage(map, column, row)) / size;
+}
+
+namespace detail
+{
+
+    CENTO_FORCEINLINE i32 windowCount(const i32 lo, const i32 hi, const i32 window, const i32 step)
+    {
+        const i64 length = i64(hi) - i64(lo);
+        if (length < window) { return 0; }
+
+        return i32((length - window) / step + 1);
+    }
+
+    /*
+     * All of the window edges along one axis, both the starts lo + i * step and
+     * the ends lo + i * step + window, in sorted order without duplicates.
+     * The index of each windows start and end within the edges is also
+     * returned so windows can be looked up without a search.
+     */
+    struct WindowEdges
+    {
+        std::vector<i32> edges;
+        std::vector<u32> starts;
+        std::vector<u32> ends;
+    };
+
+    CENTO_FORCEINLINE WindowEdges windowEdges(const i32 lo, const i32 count, const i32 window, const i32 step)
+    {
+        WindowEdges we;
+        we.edges.reserve(usize(count) * 2);
+        we.starts.reserve(usize(count));
+        we.ends.reserve(usize(count));
+
+        // merge the two arithmetic sequences of starts and ends
+        i32 s = 0;
+        i32 e = 0;
+        while (e < count)
+        {
+            const i64 start = i64(lo) + i64(s) * step;
+            const i64 end   = i64(lo) + i64(e) * step + window;
+            const i32 next  = i32((s < count) ? std::min(start, end) : end);
+
+            if (we.edges.empty() || (we.edges.back() != next)) { we.edges.push_back(next); }
+
+            const u32 index = u32(we.edges.size() - 1);
+            if ((s < count) && (start == next)) { we.starts.push_back(index); ++s; }
+            if (end == next) { we.ends.push_back(index); ++e; }
+        }
+
+        return we;
+    }
+
+}
+
+/*
+ * Compute the solid area within every window of a sliding window sweep over
+ * the extent.
+ *
+ * The window edges cut the extent into a grid of cells, a single pass over the
+ * solid tiles accumulates the area of each tile into the cells it overlaps and
+ * then a prefix sum over the cells gives the area of any window in constant
+ * time.  Tiles which are shared by many windows are therefore only visited
+ * once.
+ */
+CENTO_FORCEINLINE DensityMap densityMap(const Plane& plane,
+                                        const Rect&  extent,
+                                        const i32    window,
+                                        const i32    step)
+{
+    Expects(window > 0);
+    Expects(step > 0);
+
+    DensityMap map{.extent  = extent,
+                   .window  = window,
+                   .step    = step,
+                   .columns = detail::windowCount(extent.ll.x, extent.ur.x, window, step),
+                   .rows    = detail::windowCount(extent.ll.y, extent.ur.y, window, step),
+                   .area    = {}};
+    if ((map.columns == 0) || (map.rows == 0)) { return map; }
+
+    const detail::WindowEdges xs = detail::windowEdges(extent.ll.x, map.columns, window, step);
+    const detail::WindowEdges ys = detail::windowEdges(extent.ll.y, map.rows, window, step);
+
+    // sums has a leading row and column of zeros so that it doubles as the
+    // prefix sum table once the cells have been filled in
+    const usize      stride = xs.edges.size();
+    std::vector<i64> sums(stride * ys.edges.size(), 0);
+
+    const Rect sweep{.ll = {.x = xs.edges.front(), .y = ys.edges.front()},
+                     .ur = {.x = xs.edges.back(), .y = ys.edges.back()}};
+
+    querySolid(plane, sweep, [&](const Tile* t)
+    {
+        const i32 l = std::max(getLeft(t), sweep.ll.x);
+        const i32 b = std::max(getBottom(t), sweep.ll.y);
+        const i32 r = std::min(getRight(t), sweep.ur.x);
+        const i32 u = std::min(getTop(t), sweep.ur.y);
+        if ((l >= r) || (b >= u)) { return; }
+
+        // cell (i, j) spans edges [i - 1, i] x [j - 1, j]
+        const auto x0 = std::ranges::upper_bound(xs.edges, l) - xs.edges.begin();
+        const auto y0 = std::ranges::upper_bound(ys.edges, b) - ys.edges.begin();
+
+        for (auto j = y0; (j < isize(ys.edges.size())) && (ys.edges[j - 1] < u); ++j)
+        {
+            const i64 h = i64(std::min(ys.edges[j], u)) - std::max(ys.edges[j - 1], b);
+            for (auto i = x0; (i < isize(stride)) && (xs.edges[i - 1] < r); ++i)
+            {
+                const i64 w = i64(std::min(xs.edges[i], r)) - std::max(xs.edges[i - 1], l);
+                sums[usize(j) * stride + usize(i)] += w * h;
+            }
+        }
+    });
+
+    for (usize j = 1; j < ys.edges.size(); ++j)
+    {
+        for (usize i = 1; i < stride; ++i)
+        {
+            sums[j * stride + i] += sums[(j - 1) * stride + i] +
+                                    sums[j * stride + i - 1] -
+                                    sums[(j - 1) * stride + i - 1];
+        }
+    }
+
+    map.area.resize(usize(map.columns) * usize(map.rows));
+    for (i32 row = 0; row < map.rows; ++row)
+    {
+        const usize y1 = ys.starts[usize(row)];
+        const usize y2 = ys.ends[usize(row)];
+        for (i32 column = 0; column < map.columns; ++column)
+        {
+            const usize x1 = xs.starts[usize(column)];
+            const usize x2 = xs.ends[usize(column)];
+
+            map.area[usize(row) * usize(map.columns) + usize(column)] =
+                sums[y2 * stride + x2] - sums[y1 * stride + x2] -
+                sums[y2 * stride + x1] + sums[y1 * stride + x1];
+        }
+    }
+
+    return map;
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoDensity_hpp
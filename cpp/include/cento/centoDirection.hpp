@@ -0,0 +1,33 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoDirection_hpp
+#define centoDirection_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoDefs.hpp"
+
+CENTO_BEGIN_NAMESPACE
+
+enum struct Axis : u8
+{
+    Horizontal,
+    Vertical
+};
+
+enum struct Direction : u8
+{
+    Left,
+    Right,
+    Down,
+    Up
+};
+
+CENTO_END_NAMESPACE
+
+#endif // centoDirection_hpp
@@ -0,0 +1,221 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoEdge_hpp
+#define centoEdge_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoDirection.hpp"
+#include "centoExplore.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * A maximal boundary segment between two different bodies.
+ *
+ * A vertical edge runs from (x, bottom) to (x, top) with low being the body on
+ * its left and high the body on its right.  A horizontal edge runs from
+ * (left, y) to (right, y) with low being the body below it and high the body
+ * above it.
+ */
+struct Edge
+{
+    Point from;
+    Point to;
+    Axis  axis;
+    u64   low;
+    u64   high;
+
+    friend bool operator==(const Edge& lhs, const Edge& rhs) = default;
+};
+
+namespace detail
+{
+
+    template <typename F> requires std::invocable<F&, const Edge&>
+    CENTO_FORCEINLINE bool emitEdge(F& callback, const Edge& edge)
+    {
+        if constexpr (std::predicate<F&, const Edge&>)
+        {
+            return std::invoke(callback, edge);
+        }
+        else
+        {
+            std::invoke(callback, edge);
+            return true;
+        }
+    }
+
+    /*
+     * Whether the piece of the vertical edge at x between left and right is
+     * the top most piece of its run within the area, that is the piece above
+     * it either does not exist or separates a different pair of bodies.
+     */
+    CENTO_FORCEINLINE bool startsVertRun(const Tile* left, const Tile* right, const Rect& area)
+    {
+        const i32 top = std::min(getTop(left), getTop(right));
+        if (top >= area.ur.y) { return true; }
+
+        const Tile* la = left;
+        const Tile* ra = right;
+        if (getTop(left) <= getTop(right)) { la = rightTop(left); }
+        if (getTop(right) <= getTop(left)) { ra = leftTop(right); }
+
+        if (getRight(la) != getLeft(right)) { return true; }
+
+        return (la->id != left->id) || (ra->id != right->id);
+    }
+
+    CENTO_FORCEINLINE bool startsHorzRun(const Tile* below, const Tile* above, const Rect& area)
+    {
+        const i32 right = std::min(getRight(below), getRight(above));
+        if (right >= area.ur.x) { return true; }
+
+        const Tile* br = below;
+        const Tile* ar = above;
+        if (getRight(below) <= getRight(above)) { br = topRight(below); }
+        if (getRight(above) <= getRight(below)) { ar = bottomRight(above); }
+
+        if (getTop(br) != getBottom(above)) { return true; }
+
+        return (br->id != below->id) || (ar->id != above->id);
+    }
+
+    /*
+     * Follow a run of pieces down the vertical edge from its top most piece,
+     * stepping the tile on each side down only when its piece ends.
+     */
+    template <typename F> requires std::invocable<F&, const Edge&>
+    bool walkVertRun(const Tile* left, const Tile* right, const Rect& area, F& callback)
+    {
+        const i32 x   = getRight(left);
+        const u64 low = left->id;
+        const u64 hi  = right->id;
+        const i32 top = std::min({getTop(left), getTop(right), area.ur.y});
+
+        i32 bottom = std::max(getBottom(left), getBottom(right));
+        while (bottom > area.ll.y)
+        {
+            const Tile* l = (getBottom(left) == bottom) ? rightBottom(left) : left;
+            const Tile* r = (getBottom(right) == bottom) ? leftBottom(right) : right;
+            if ((getRight(l) != x) || (l->id != low) || (r->id != hi)) { break; }
+
+            left   = l;
+            right  = r;
+            bottom = std::max(getBottom(left), getBottom(right));
+        }
+        bottom = std::max(bottom, area.ll.y);
+
+        return emitEdge(callback, Edge{.from = {x, bottom},
+                                       .to   = {x, top},
+                                       .axis = Axis::Vertical,
+                                       .low  = low,
+                                       .high = hi});
+    }
+
+    template <typename F> requires std::invocable<F&, const Edge&>
+    bool walkHorzRun(const Tile* below, const Tile* above, const Rect& area, F& callback)
+    {
+        const i32 y     = getTop(below);
+        const u64 low   = below->id;
+        const u64 hi    = above->id;
+        const i32 right = std::min({getRight(below), getRight(above), area.ur.x});
+
+        i32 left = std::max(getLeft(below), getLeft(above));
+        while (left > area.ll.x)
+        {
+            const Tile* b = (getLeft(below) == left) ? topLeft(below) : below;
+            const Tile* a = (getLeft(above) == left) ? bottomLeft(above) : above;
+            if ((getTop(b) != y) || (b->id != low) || (a->id != hi)) { break; }
+
+            below = b;
+            above = a;
+            left  = std::max(getLeft(below), getLeft(above));
+        }
+        left = std::max(left, area.ll.x);
+
+        return emitEdge(callback, Edge{.from = {left, y},
+                                       .to   = {right, y},
+                                       .axis = Axis::Horizontal,
+                                       .low  = low,
+                                       .high = hi});
+    }
+
+}
+
+/*
+ * Enumerate the maximal segments of the boundaries between different bodies
+ * (solid and space, or two different solid ids) which lie inside of the area.
+ *
+ * Every tile in the area is visited once, the vertical edges are found along
+ * its right side and the horizontal edges along its top side so each shared
+ * edge is only looked at from one of its tiles.  Only the top (or right) most
+ * piece of a run starts a segment, the run is then followed across the
+ * stitches until the bodies on either side change.
+ *
+ * Edges on the boundary of the area are not reported, segments are clipped to
+ * the area.
+ */
+template <typename F> requires std::invocable<F&, const Edge&>
+void enumerateEdges(const Plane& plane, const Rect& area, F&& callback)
+{
+    query(plane, area, [&](Tile* t) -> bool
+    {
+        const i32 x = getRight(t);
+        if ((x > area.ll.x) && (x < area.ur.x))
+        {
+            bool more = true;
+            rightTiles(t, [&](Tile* r) -> bool
+            {
+                if (t->id == r->id) { return true; }
+
+                const i32 top    = std::min(getTop(t), getTop(r));
+                const i32 bottom = std::max(getBottom(t), getBottom(r));
+                if ((top <= area.ll.y) || (bottom >= area.ur.y)) { return true; }
+
+                if (not detail::startsVertRun(t, r, area)) { return true; }
+
+                more = detail::walkVertRun(t, r, area, callback);
+                return more;
+            });
+            if (not more) { return false; }
+        }
+
+        const i32 y = getTop(t);
+        if ((y > area.ll.y) && (y < area.ur.y))
+        {
+            bool more = true;
+            topTiles(t, [&](Tile* a) -> bool
+            {
+                if (t->id == a->id) { return true; }
+
+                const i32 right = std::min(getRight(t), getRight(a));
+                const i32 left  = std::max(getLeft(t), getLeft(a));
+                if ((right <= area.ll.x) || (left >= area.ur.x)) { return true; }
+
+                if (not detail::startsHorzRun(t, a, area)) { return true; }
+
+                more = detail::walkHorzRun(t, a, area, callback);
+                return more;
+            });
+            if (not more) { return false; }
+        }
+
+        return true;
+    });
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoEdge_hpp
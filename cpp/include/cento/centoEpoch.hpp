@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoEpoch_hpp
+#define centoEpoch_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoDefs.hpp"
+#include "centoMacros.hpp"
+#include "centoTile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * Epoch based reclamation of the tiles freed by edits.
+ *
+ * A reader pins the current epoch before taking any tile pointers and unpins
+ * it once it holds no more.  The writer retires freed tiles with the epoch they
+ * were unlinked in and only recycles them once every pinned reader has moved
+ * past that epoch, so a tile pointer a pinned reader holds is never handed out
+ * again as some other tile.
+ *
+ * That is all a pin guarantees, it does not make reads lock free.  The fields
+ * of a tile are plain memory which edits write in place, and a split or join
+ * rewrites the stitches of several tiles in no particular order, so a query
+ * run alongside an edit is a data race whether or not it is pinned.  Point and
+ * region queries must still hold a SharedPlane read lock or read from a
+ * snapshot, a pin only lets a reader keep its tile pointers from one locked
+ * read to the next.
+ */
+struct EpochDomain
+{
+    static constexpr const usize Slots = 64;
+    static constexpr const u64   Idle  = 0;
+
+    struct Retired
+    {
+        u64   epoch;
+        Tile* tile;
+    };
+
+    std::atomic<u64>                    epoch = 1;
+    std::array<std::atomic<u64>, Slots> pinned{};
+    std::vector<Retired>                retired;
+};
+
+/*
+ * Holds an epoch pinned for as long as it lives.
+ */
+class EpochGuard
+{
+public:
+    explicit EpochGuard(EpochDomain& domain) noexcept
+    {
+        // Claim a free slot, waiting for one if every slot is in use.
+        for (usize i = 0; slot_ == nullptr; i = (i + 1) % EpochDomain::Slots)
+        {
+            u64 expected = EpochDomain::Idle;
+            if (domain.pinned[i].compare_exchange_strong(expected, domain.epoch.load()))
+            {
+                slot_ = &domain.pinned[i];
+            }
+            else if (i == EpochDomain::Slots - 1)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The epoch may have moved on between reading it and publishing it, in
+        // which case the writer may not have seen this reader, so republish
+        // until the two agree.
+        for (u64 e = domain.epoch.load(); slot_->load() != e; e = domain.epoch.load())
+        {
+            slot_->store(e);
+        }
+    }
+
+    EpochGuard(const EpochGuard&)            = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+    ~EpochGuard()
+    {
+        slot_->store(EpochDomain::Idle, std::memory_order_release);
+    }
+
+private:
+    std::atomic<u64>* slot_ = nullptr;
+};
+
+/*
+ * Retire a tile which the writer has just unlinked from the plane.
+ */
+CENTO_FORCEINLINE void retire(EpochDomain& domain, Tile* tile)
+{
+    domain.retired.push_back({domain.epoch.load(std::memory_order_relaxed), tile});
+}
+
+/*
+ * Move on to the next epoch and recycle every retired tile no pinned reader can
+ * still see, this must only be called by the writer.
+ */
+template <typename F> requires std::invocable<F&, Tile*>
+CENTO_FORCEINLINE void reclaim(EpochDomain& domain, F&& recycle)
+{
+    if (domain.retired.empty()) { return; }
+
+    const u64 now    = domain.epoch.fetch_add(1) + 1;
+    u64       oldest = now;
+    for (const std::atomic<u64>& p : domain.pinned)
+    {
+        const u64 e = p.load();
+        if (e != EpochDomain::Idle) { oldest = std::min(oldest, e); }
+    }
+
+    std::erase_if(domain.retired, [&](const EpochDomain::Retired& r)
+    {
+        if (r.epoch >= oldest) { return false; }
+
+        recycle(r.tile);
+        return true;
+    });
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoEpoch_hpp
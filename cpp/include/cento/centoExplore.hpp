@@ -100,52 +100,105 @@ CENTO_FORCEINLINE void rightTiles(const Tile* tile, F&& callback)
                          [](const Tile* t) { return leftBottom(t); });
 }
 
-CENTO_FORCEINLINE bool empty(const Plane& plane, const Rect& area)
+namespace detail
 {
-    // 1. Use the point finding algorithm to locate the tile containing the
-    //    lower-left corner of the area of interest.
-    cento::Point here = {area.ll.x, area.ur.y - 1};
-    cento::Tile* tile = cento::findTileAt(plane, here);
 
-    i64 here_y = here.y;
-    while(here_y >= area.ll.y)
+    /*
+     * Report each solid tile of the same id as the tile which shares some of
+     * an edge with it, those which together with it make up a single shape.
+     */
+    template <typename F> requires std::invocable<F&, Tile*>
+    CENTO_FORCEINLINE void joinedTiles(const Tile* tile, F& callback)
     {
-        // 2. See if the tile is solid. If not, it must be a space tile. See if
-        //    its right edge is within the area of interest. If so, either it is
-        //    the edge of the layout or the edge of a solid tile.
-        if (isSolid(tile) && (getRight(tile) > area.ll.x)) { return false; }
-
-        // 3. If a solid tile was found in step 2, then the search is complete.
-        //    If no solid tile was found, then move upwards to the next tile
-        //    touching the left edge of the area of interest. This can be done
-        //    either by invoking the point-finding algorithm, or by traversing
-        //    the lt stitch upwards and then traversing the br stitches right
-        //    until the desired tile is found.
-        if (getRight(tile) < area.ur.x)
+        auto same = [&](Tile* n)
         {
-            const Tile* const right = topRight(tile);
-            if (isSolid(right) || (getRight(right) < area.ur.x)) { return false; }
-        }
+            if (isSolid(n) && (n->id == tile->id)) { std::invoke(callback, n); }
+        };
+        topTiles(tile, same);
+        leftTiles(tile, same);
+        bottomTiles(tile, same);
+        rightTiles(tile, same);
+    }
+
+    template <typename View = Live>
+    CENTO_FORCEINLINE bool emptyArea(Tile*& hint, const Rect& area, View&& view = View{})
+    {
+        // 1. Use the point finding algorithm to locate the tile containing the
+        //    lower-left corner of the area of interest.
+        cento::Point here = {area.ll.x, area.ur.y - 1};
+        cento::Tile* tile = detail::locate(hint, here, view);
+
+        i64 here_y = here.y;
+        while(here_y >= area.ll.y)
+        {
+            // 2. See if the tile is solid. If not, it must be a space tile. See if
+            //    its right edge is within the area of interest. If so, either it is
+            //    the edge of the layout or the edge of a solid tile.
+            if (isSolid(view(tile)) && (getRight(view(tile)) > area.ll.x)) { return false; }
+
+            // 3. If a solid tile was found in step 2, then the search is complete.
+            //    If no solid tile was found, then move upwards to the next tile
+            //    touching the left edge of the area of interest. This can be done
+            //    either by invoking the point-finding algorithm, or by traversing
+            //    the lt stitch upwards and then traversing the br stitches right
+            //    until the desired tile is found.
+            if (getRight(view(tile)) < area.ur.x)
+            {
+                Tile* const right = topRight(view(tile));
+                if (isSolid(view(right)) || (getRight(view(right)) < area.ur.x)) { return false; }
+            }
+
+            here_y = i64(getBottom(view(tile))) - 1;
+            here.y = i32(here_y);
+            tile   = detail::locate(hint, here, view);
 
-        here_y = i64(getBottom(tile)) - 1;
-        here.y = i32(here_y);
-        tile   = cento::findTileAt(plane, here);
+            // 4. Repeat steps 2 and 3 until either a solid tile is found or the top
+            //    of the area of interest is reached.
+        }
 
-        // 4. Repeat steps 2 and 3 until either a solid tile is found or the top
-        //    of the area of interest is reached.
+        return true;
     }
 
-    return true;
+}
+
+CENTO_FORCEINLINE bool empty(const Plane& plane, const Rect& area)
+{
+    return detail::emptyArea(plane.hint, area);
 }
 
 namespace detail
 {
 
-    template <typename F> requires std::invocable<F&&, Tile*>
+    /*
+     * Report a single tile to the client, returns false if the client asked
+     * for the enumeration to stop.  When only solid tiles are wanted the space
+     * tiles are skipped here without ever calling the client.
+     */
+    template <bool SolidOnly, typename T, typename F> requires std::invocable<F&&, T*>
+    CENTO_FORCEINLINE bool report(T* tile, F&& callback)
+    {
+        if constexpr (SolidOnly)
+        {
+            if (isSpace(tile)) { return true; }
+        }
+
+        if constexpr (std::predicate<F&&, T*>)
+        {
+            return std::invoke(std::forward<F>(callback), tile);
+        }
+        else
+        {
+            std::invoke(std::forward<F>(callback), tile);
+            return true;
+        }
+    }
+
+    template <bool SolidOnly, typename F, typename View = Live> requires std::invocable<F&&, Tile*>
     bool areaEnum(Tile*       enumRT,
                   i32         enumBottom,
                   const Rect& area,
-                  F&&         callback)
+                  F&&         callback,
+                  View&&      view = View{})
     {
         const bool atBottom = (enumBottom <= area.ll.y);
 
@@ -163,7 +216,7 @@ namespace detail
         Tile* tp;
         Tile* tpLB;
         i32   tpNextTop;
-        for (tp = enumRT, tpNextTop = getTop(tp); tpNextTop > srchBottom; tp = tpLB)
+        for (tp = enumRT, tpNextTop = getTop(view(tp)); tpNextTop > srchBottom; tp = tpLB)
         {
             /*
              * Since the client's filter function may result in this tile
@@ -172,28 +225,21 @@ namespace detail
              * apply the filter function.
              */
 
-            tpLB      = leftBottom(tp);
-            tpNextTop = tpLB ? getTop(tpLB) : nInfinity; /* Since getTop(tpLB) comes from tp */
+            tpLB      = leftBottom(view(tp));
+            tpNextTop = tpLB ? getTop(view(tpLB)) : nInfinity; /* Since getTop(tpLB) comes from tp */
 
-            if ((getBottom(tp) < area.ur.y) && (atBottom || (getBottom(tp) >= enumBottom)))
+            if ((getBottom(view(tp)) < area.ur.y) && (atBottom || (getBottom(view(tp)) >= enumBottom)))
             {
                 /*
                  * We extract more information from the tile, which we will use
                  * after applying the filter function.
                  */
 
-                i32   tpRight  = getRight(tp);
-                i32   tpBottom = getBottom(tp);
-                Tile* tpTR     = topRight(tp);
+                i32   tpRight  = getRight(view(tp));
+                i32   tpBottom = getBottom(view(tp));
+                Tile* tpTR     = topRight(view(tp));
 
-                if constexpr (std::predicate<F&&, Tile*>)
-                {
-                    if (not std::invoke(std::forward<F>(callback), tp)) { return true; }
-                }
-                else
-                {
-                    std::invoke(std::forward<F>(callback), tp);
-                }
+                if (not report<SolidOnly>(view(tp), std::forward<F>(callback))) { return true; }
 
                 /*
                  * If the right boundary of the tile being enumerated is
@@ -203,7 +249,7 @@ namespace detail
 
                 if (tpRight < area.ur.x)
                 {
-                    if (areaEnum(tpTR, tpBottom, area, std::forward<F>(callback))) { return true; }
+                    if (areaEnum<SolidOnly>(tpTR, tpBottom, area, std::forward<F>(callback), view)) { return true; }
                 }
             }
         }
@@ -211,55 +257,85 @@ namespace detail
         return false;
     }
 
+    template <bool SolidOnly, typename F, typename View = Live> requires std::invocable<F&&, Tile*>
+    CENTO_FORCEINLINE void queryArea(Tile*& hint, const Rect& area, F&& callback, View&& view = View{})
+    {
+        cento::Point here     = {area.ll.x, area.ur.y - 1};
+        cento::Tile* enumTile = detail::locate(hint, here, view);
+
+        i64 here_y = here.y;
+        while(here_y >= area.ll.y)
+        {
+            /*
+             * Find the tile (tp) immediately below the one to be
+             * enumerated (enumTile).  This must be done before we enumerate
+             * the tile, as the filter function applied to enumerate
+             * it can result in its deallocation or modification in
+             * some other way.
+             *
+             * We also have to be sure we do not overflow from the infinity tile
+             */
+
+            here_y          = i64(getBottom(view(enumTile))) - 1;
+            here.y          = i32(here_y);
+            cento::Tile* tp = detail::locate(hint, here, view);
+
+            cento::Point enumRB = {getRight(view(enumTile)), getBottom(view(enumTile))};
+            cento::Tile* enumTR = topRight(view(enumTile));
+
+            if (not report<SolidOnly>(view(enumTile), std::forward<F>(callback))) { return; }
+
+            /*
+             * If the right boundary of the tile being enumerated is
+             * inside of the search area, recursively enumerate
+             * tiles to its right.
+             */
+
+            if (enumRB.x < area.ur.x)
+            {
+                if (areaEnum<SolidOnly>(enumTR, enumRB.y, area, std::forward<F>(callback), view)) { return; }
+            }
+            enumTile = tp;
+        }
+    }
+
 }
 
 template <typename F> requires std::invocable<F&&, Tile*>
 CENTO_FORCEINLINE void query(const Plane& plane, const Rect& area, F&& callback)
 {
-    cento::Point here     = {area.ll.x, area.ur.y - 1};
-    cento::Tile* enumTile = cento::findTileAt(plane, here);
-
-    i64 here_y = here.y;
-    while(here_y >= area.ll.y)
-    {
-        /*
-         * Find the tile (tp) immediately below the one to be
-         * enumerated (enumTile).  This must be done before we enumerate
-         * the tile, as the filter function applied to enumerate
-         * it can result in its deallocation or modification in
-         * some other way.
-         * 
-         * We also have to be sure we do not overflow from the infinity tile
-         */
-
-        here_y          = i64(getBottom(enumTile)) - 1;
-        here.y          = i32(here_y);
-        cento::Tile* tp = cento::findTileAt(plane, here);
+    detail::queryArea<false>(plane.hint, area, std::forward<F>(callback));
+}
 
-        cento::Point enumRB = {getRight(enumTile), getBottom(enumTile)};
-        cento::Tile* enumTR = topRight(enumTile);
+/*
+ * Enumerate only the solid tiles within the area.  This is filtering only, the
+ * walk is the same as that of query: the solid tiles are reached through the
+ * space between them, so every space tile in the area is still visited.  They
+ * are just never reported to the client.
+ */
+template <typename F> requires std::invocable<F&&, Tile*>
+CENTO_FORCEINLINE void querySolid(const Plane& plane, const Rect& area, F&& callback)
+{
+    detail::queryArea<true>(plane.hint, area, std::forward<F>(callback));
+}
 
-        if constexpr (std::predicate<F&&, Tile*>)
-        {
-            if (not std::invoke(std::forward<F>(callback), enumTile)) { return; }
-        }
-        else
-        {
-            std::invoke(std::forward<F>(callback), enumTile);
-        }
+/*
+ * Count the solid tiles within the area, by the same walk as querySolid.
+ */
+CENTO_FORCEINLINE usize countSolid(const Plane& plane, const Rect& area)
+{
+    usize count = 0;
+    detail::queryArea<true>(plane.hint, area, [&](const Tile*) { ++count; });
 
-        /*
-         * If the right boundary of the tile being enumerated is
-         * inside of the search area, recursively enumerate
-         * tiles to its right.
-         */
+    return count;
+}
 
-        if (enumRB.x < area.ur.x)
-        {
-            if (detail::areaEnum(enumTR, enumRB.y, area, std::forward<F>(callback))) { return; }
-        }
-        enumTile = tp;
-    }
+CENTO_FORCEINLINE bool anySolid(const Plane& plane, const Rect& area)
+{
+    // A space tile is always bordered on its left and right by solid tiles, so
+    // the walk down the left edge of the area done by empty is sufficient.
+    // Unlike querySolid this does not visit the space inside the area.
+    return not empty(plane, area);
 }
 
 template <typename F> requires std::invocable<F&&, Tile*>
@@ -15,59 +15,97 @@
 
 CENTO_BEGIN_NAMESPACE
 
-CENTO_FORCEINLINE Tile* findTileAt(Tile*        start,
-                                   const Point& point)
+namespace detail
 {
-    Tile* t = start;
 
-    // 1. First move up (or down) along the left edges of tiles until a tile
-    //    is found whose vertical range contains the desired point.
-    if (point.y < getBottom(t))
+    /*
+     * Reads tiles as they are now, searches through a snapshot instead read
+     * each tile as it was when the snapshot was taken.
+     */
+    struct Live
     {
-        do { t = leftBottom(t); } while (t && (point.y < getBottom(t)));
-    }
-    else
+        CENTO_FORCEINLINE Tile* operator()(Tile* tile) const noexcept
+        {
+            return tile;
+        }
+    };
+
+    template <typename View>
+    CENTO_FORCEINLINE Tile* findTileAt(Tile*        start,
+                                       const Point& point,
+                                       View&&       view)
     {
-        while (t && (point.y >= getTop(t))) { t = rightTop(t); }
-    }
+        Tile* t = start;
+
+        // 1. First move up (or down) along the left edges of tiles until a tile
+        //    is found whose vertical range contains the desired point.
+        if (point.y < getBottom(view(t)))
+        {
+            do { t = leftBottom(view(t)); } while (t && (point.y < getBottom(view(t))));
+        }
+        else
+        {
+            while (t && (point.y >= getTop(view(t)))) { t = rightTop(view(t)); }
+        }
 
-    if (t == nullptr) { return nullptr; }
+        if (t == nullptr) { return nullptr; }
 
-    // 2. Then move left (or right) along the bottom edges of tiles until a
-    //    tile is found whose horizontal range contains the desired point.
-    if (point.x < getLeft(t))
-    {
-        do
+        // 2. Then move left (or right) along the bottom edges of tiles until a
+        //    tile is found whose horizontal range contains the desired point.
+        if (point.x < getLeft(view(t)))
         {
-            do { t = bottomLeft(t); } while (t && (point.x < getLeft(t)));
-            if ((t == nullptr) || (point.y < getTop(t))) { break; }
-            do { t = rightTop(t); } while (point.y >= getTop(t));
-        } while (point.x < getLeft(t));
-
-        // 3. Since the horizontal motion may have caused a vertical
-        //    misalignment, steps 1 and 2 may have to be iterated several times
-        //    to locate the tile containing the point.
-    }
-    else
-    {
-        while (point.x >= getRight(t))
+            do
+            {
+                do { t = bottomLeft(view(t)); } while (t && (point.x < getLeft(view(t))));
+                if ((t == nullptr) || (point.y < getTop(view(t)))) { break; }
+                do { t = rightTop(view(t)); } while (point.y >= getTop(view(t)));
+            } while (point.x < getLeft(view(t)));
+
+            // 3. Since the horizontal motion may have caused a vertical
+            //    misalignment, steps 1 and 2 may have to be iterated several times
+            //    to locate the tile containing the point.
+        }
+        else
         {
-            do t = topRight(t); while (t && (point.x >= getRight(t)));
-            if ((t == nullptr) || (point.y >= getBottom(t))) { break; }
-            do t = leftBottom(t); while (t && (point.y < getBottom(t)));
-            if (t == nullptr) { break; }
+            while (point.x >= getRight(view(t)))
+            {
+                do t = topRight(view(t)); while (t && (point.x >= getRight(view(t))));
+                if ((t == nullptr) || (point.y >= getBottom(view(t)))) { break; }
+                do t = leftBottom(view(t)); while (t && (point.y < getBottom(view(t))));
+                if (t == nullptr) { break; }
+            }
         }
+
+        return t;
     }
 
-    return t;
 }
 
-CENTO_FORCEINLINE Tile* findTileAt(const Plane& plane, const Point& point)
+CENTO_FORCEINLINE Tile* findTileAt(Tile*        start,
+                                   const Point& point)
+{
+    return detail::findTileAt(start, point, detail::Live{});
+}
+
+namespace detail
 {
-    Tile* t = findTileAt(plane.hint, point);
-    if (t) { plane.hint = t; }
 
-    return t;
+    // Find the tile at the point starting from and then updating a hint which
+    // is owned by the caller, so searches never have to share a hint.
+    template <typename View = Live>
+    CENTO_FORCEINLINE Tile* locate(Tile*& hint, const Point& point, View&& view = View{})
+    {
+        Tile* t = detail::findTileAt(hint, point, view);
+        if (t) { hint = t; }
+
+        return t;
+    }
+
+}
+
+CENTO_FORCEINLINE Tile* findTileAt(const Plane& plane, const Point& point)
+{
+    return detail::locate(plane.hint, point);
 }
 
 CENTO_END_NAMESPACE
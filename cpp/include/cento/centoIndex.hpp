@@ -0,0 +1,289 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoIndex_hpp
+#define centoIndex_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoCreate.hpp"
+#include "centoExplore.hpp"
+#include "centoInsert.hpp"
+#include "centoJoin.hpp"
+#include "centoMerge.hpp"
+#include "centoPlane.hpp"
+#include "centoRemove.hpp"
+#include "centoSplit.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * An index of the bounding boxes of a set of items, such as the placements of
+ * a cell, which may overlap each other.
+ *
+ * The boxes are kept in a plane of their own where the area covered by any box
+ * is solid, the id of each solid tile picks out the list of the items whose
+ * boxes cover the whole of it.  Adding a box fills the space within it with new
+ * tiles and adds the item to the lists of the tiles already there, first
+ * cutting those which reach beyond the box at its edges so that the pieces
+ * outside keep a copy of the list they had.
+ *
+ * Erasing a box takes the item off the lists it was added to and removes the
+ * tiles left with no items.  Tiles whose lists were changed by adding or
+ * erasing a box are joined to any tile beside them listing the same items, so
+ * that the gaps a box is drawn in are not left as separate pieces and the cuts
+ * made by boxes which have gone do not build up as boxes move about.
+ *
+ * A query only walks the tiles within the window and every item listed by one
+ * of them has a box overlapping the window, so it costs in proportion to the
+ * tiles and items found, not the items in the index.
+ */
+struct PlacementIndex
+{
+    Plane                         plane;
+    std::vector<Rect>             boxes;
+    std::vector<std::vector<u32>> lists;
+    std::vector<u64>              free;
+    mutable std::vector<u64>      seen;
+    mutable u64                   stamp = 0;
+};
+
+CENTO_FORCEINLINE Tile* createUniverse(PlacementIndex& index)
+{
+    return createUniverse(index.plane);
+}
+
+namespace detail
+{
+
+    CENTO_FORCEINLINE u64 newList(PlacementIndex& index, const u32 item)
+    {
+        if (index.free.empty())
+        {
+            index.lists.push_back({item});
+            return index.lists.size() - 1;
+        }
+
+        const u64 list = index.free.back();
+        index.free.pop_back();
+        index.lists[list].push_back(item);
+
+        return list;
+    }
+
+    CENTO_FORCEINLINE u64 copyList(PlacementIndex& index, const u64 from)
+    {
+        std::vector<u32> items = index.lists[from];
+        if (index.free.empty())
+        {
+            index.lists.push_back(std::move(items));
+            return index.lists.size() - 1;
+        }
+
+        const u64 list = index.free.back();
+        index.free.pop_back();
+        index.lists[list] = std::move(items);
+
+        return list;
+    }
+
+    /*
+     * Cut the solid tile at the edges of the box, each piece outside of the
+     * box getting a copy of its list, and return the piece inside.  The
+     * pieces outside are added to the cut tiles.
+     */
+    CENTO_FORCEINLINE Tile* cutToBox(PlacementIndex& index, Tile* t, const Rect& box, std::vector<Tile*>& cut)
+    {
+        if (const HorzSplit s = splitTileHorz(index.plane, t, box.ll.y))
+        {
+            s.upper->id = copyList(index, t->id);
+            cut.push_back(s.lower);
+            t = s.upper;
+        }
+        if (const HorzSplit s = splitTileHorz(index.plane, t, box.ur.y))
+        {
+            s.upper->id = copyList(index, t->id);
+            cut.push_back(s.upper);
+        }
+        if (const VertSplit s = splitTileVert(index.plane, t, box.ll.x))
+        {
+            s.right->id = copyList(index, t->id);
+            cut.push_back(s.left);
+            t = s.right;
+        }
+        if (const VertSplit s = splitTileVert(index.plane, t, box.ur.x))
+        {
+            s.right->id = copyList(index, t->id);
+            cut.push_back(s.right);
+        }
+
+        return t;
+    }
+
+    // Whether both tiles are solid and list the same items.
+    CENTO_FORCEINLINE bool sameItems(const PlacementIndex& index, const Tile* a, const Tile* b)
+    {
+        if ((a == nullptr) || (b == nullptr) || isSpace(a) || isSpace(b)) { return false; }
+
+        const std::vector<u32>& la = index.lists[a->id];
+        const std::vector<u32>& lb = index.lists[b->id];
+
+        return (la.size() == lb.size()) && std::is_permutation(la.begin(), la.end(), lb.begin());
+    }
+
+    /*
+     * Join each of the tiles to any tile beside it listing the same items and
+     * sharing the whole of an edge with it, over and over until none can be
+     * joined.  The list of the tile joined away is freed.
+     */
+    CENTO_FORCEINLINE void coalesce(PlacementIndex& index, std::vector<Tile*> tiles)
+    {
+        std::unordered_set<Tile*> pending(tiles.begin(), tiles.end());
+
+        auto drop = [&](Tile* gone)
+        {
+            index.lists[gone->id].clear();
+            index.free.push_back(gone->id);
+            pending.erase(gone);
+        };
+
+        while (not tiles.empty())
+        {
+            Tile* t = tiles.back();
+            tiles.pop_back();
+            if (not pending.erase(t)) { continue; }
+
+            for (;;)
+            {
+                if (Tile* const above = rightTop(t); sameItems(index, t, above) && canMergeHorz(above, t))
+                {
+                    drop(above);
+                    t = joinTileHorz(index.plane, above, t);
+                }
+                else if (Tile* const below = leftBottom(t); sameItems(index, t, below) && canMergeHorz(t, below))
+                {
+                    drop(t);
+                    t = joinTileHorz(index.plane, t, below);
+                }
+                else if (Tile* const right = topRight(t); sameItems(index, t, right) && canMergeVert(t, right))
+                {
+                    drop(right);
+                    t = joinTileVert(index.plane, t, right);
+                }
+                else if (Tile* const left = bottomLeft(t); sameItems(index, t, left) && canMergeVert(left, t))
+                {
+                    drop(t);
+                    t = joinTileVert(index.plane, left, t);
+                }
+                else { break; }
+            }
+        }
+    }
+
+}
+
+CENTO_FORCEINLINE void insertBox(PlacementIndex& index, const u32 item, const Rect& box)
+{
+    Expects((box.ll.x < box.ur.x) && (box.ll.y < box.ur.y));
+
+    if (index.boxes.size() <= item)
+    {
+        index.boxes.resize(item + 1);
+        index.seen.resize(item + 1, 0);
+    }
+    index.boxes[item] = box;
+
+    std::vector<Rect>  gaps;
+    std::vector<Tile*> covered;
+    query(index.plane, box, [&](Tile* t)
+    {
+        if (isSpace(t)) { gaps.push_back(intersection(getRect(t), box)); }
+        else { covered.push_back(t); }
+    });
+
+    // cutting a solid tile leaves the space and the other solid tiles as
+    // they were, so both lists stay good while the tiles are cut
+    std::vector<Tile*> changed;
+    for (Tile* t : covered)
+    {
+        t = detail::cutToBox(index, t, box, changed);
+        index.lists[t->id].push_back(item);
+        changed.push_back(t);
+    }
+
+    // each gap is part of a different space tile so filling one never touches
+    // the others
+    for (const Rect& gap : gaps)
+    {
+        Tile* const t = insertTile(index.plane, {.id = detail::newList(index, item), .rect = gap});
+        Ensures(t != nullptr);
+        changed.push_back(t);
+    }
+
+    detail::coalesce(index, std::move(changed));
+}
+
+CENTO_FORCEINLINE void eraseBox(PlacementIndex& index, const u32 item)
+{
+    std::vector<Tile*> emptied;
+    std::vector<Tile*> shrunk;
+    querySolid(index.plane, index.boxes[item], [&](Tile* t)
+    {
+        std::vector<u32>& list = index.lists[t->id];
+        std::erase(list, item);
+        (list.empty() ? emptied : shrunk).push_back(t);
+    });
+
+    // removing a tile only ever changes the space around it, so the tiles
+    // still listing items are left as they were
+    for (Tile* const t : emptied)
+    {
+        index.free.push_back(t->id);
+        removeTile(index.plane, t);
+    }
+
+    detail::coalesce(index, std::move(shrunk));
+}
+
+CENTO_FORCEINLINE void moveBox(PlacementIndex& index, const u32 item, const Rect& box)
+{
+    eraseBox(index, item);
+    insertBox(index, item, box);
+}
+
+/*
+ * Report each item whose box overlaps the window once, the callback is called
+ * as callback(item).
+ */
+template <typename F> requires std::invocable<F&, u32>
+CENTO_FORCEINLINE void queryBoxes(const PlacementIndex& index, const Rect& window, F&& callback)
+{
+    const u64 stamp = ++index.stamp;
+    querySolid(index.plane, window, [&](Tile* t)
+    {
+        for (const u32 item : index.lists[t->id])
+        {
+            if (index.seen[item] == stamp) { continue; }
+            index.seen[item] = stamp;
+
+            if (overlaps(index.boxes[item], window)) { std::invoke(callback, item); }
+        }
+    });
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoIndex_hpp
@@ -20,12 +20,16 @@ CENTO_BEGIN_NAMESPACE
 
 CENTO_FORCEINLINE Tile* insertTile(Plane& plane, const TilePlan& plan)
 {
+    const auto lock = lockEdit(plane);
+
     if (not empty(plane, plan.rect)) { return nullptr; }
 
+    record(plane, Change::Body, plan.rect);
+
     // 1. Find the space tile containing the top edge of the area to be occupied
     //    by the new tile (because of the strip property, a single space tile
     //    must contain the entire edge).
-    Tile* t = findTileAt(plane, plan.rect.ur);
+    Tile* t = findTileAt(plane, {plan.rect.ll.x, plan.rect.ur.y - 1});
 
     // 2. Split the top space tile along a horizontal line into a piece entirely
     //    above the new tile and a piece overlapping the new tile. Update corner
@@ -58,9 +62,13 @@ CENTO_FORCEINLINE Tile* insertTile(Plane& plane, const TilePlan& plan)
             mergeDown(plane, split.right);
         }
 
-        if (Tile* const merge = mergeDown(plane, tile); merge != nullptr)
+        // the bottom piece of the new tile must not take in the space below it
+        if (getBottom(tile) > plan.rect.ll.y)
         {
-            tile = merge;
+            if (Tile* const merge = mergeDown(plane, tile); merge != nullptr)
+            {
+                tile = merge;
+            }
         }
 
         if (t == ret) { ret = tile; }
@@ -70,8 +78,11 @@ CENTO_FORCEINLINE Tile* insertTile(Plane& plane, const TilePlan& plan)
     [=](Tile* t) { return getTop(t) >= plan.rect.ur.y; },
     [](Tile* t) { return rightTop(t); });
 
+    preserve(plane, ret);
     ret->id = plan.id;
 
+    notify(plane);
+
     return ret;
 }
 
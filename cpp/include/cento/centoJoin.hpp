@@ -42,6 +42,7 @@ CENTO_FORCEINLINE Tile* joinTileHorz(Plane& plane, Tile* upper, Tile* lower)
 
     for (tp = topRight(upper); tp && bottomLeft(tp) == upper; tp = leftBottom(tp))
     {
+        preserve(plane, tp);
         bottomLeft(tp) = lower;
     }
 
@@ -51,17 +52,22 @@ CENTO_FORCEINLINE Tile* joinTileHorz(Plane& plane, Tile* upper, Tile* lower)
 
     for (tp = bottomLeft(upper); tp && topRight(tp) == upper; tp = rightTop(tp))
     {
+        preserve(plane, tp);
         topRight(tp) = lower;
     }
 
     for (tp = rightTop(upper); tp && leftBottom(tp) == upper; tp = bottomLeft(tp))
     {
+        preserve(plane, tp);
         leftBottom(tp) = lower;
     }
+    preserve(plane, lower);
     rightTop(lower) = rightTop(upper);
     topRight(lower) = topRight(upper);
     setTop(lower, getTop(upper));
 
+    record(plane, Change::Merge, getRect(lower));
+
     if (plane.hint == upper) { plane.hint = lower; }
     put(plane, upper);
 
@@ -93,6 +99,7 @@ CENTO_FORCEINLINE Tile* joinTileVert(Plane& plane, Tile* left, Tile* right)
 
     for (tp = rightTop(right); tp && leftBottom(tp) == right; tp = bottomLeft(tp))
     {
+        preserve(plane, tp);
         leftBottom(tp) = left;
     }
 
@@ -102,6 +109,7 @@ CENTO_FORCEINLINE Tile* joinTileVert(Plane& plane, Tile* left, Tile* right)
 
     for (tp = leftBottom(right); tp && rightTop(tp) == right; tp = topRight(tp))
     {
+        preserve(plane, tp);
         rightTop(tp) = left;
     }
 
@@ -112,12 +120,16 @@ CENTO_FORCEINLINE Tile* joinTileVert(Plane& plane, Tile* left, Tile* right)
 
     for (tp = topRight(right); tp && bottomLeft(tp) == right; tp = leftBottom(tp))
     {
+        preserve(plane, tp);
         bottomLeft(tp) = left;
     }
+    preserve(plane, left);
     topRight(left) = topRight(right);
     rightTop(left) = rightTop(right);
     setRight(left, getRight(right));
 
+    record(plane, Change::Merge, getRect(left));
+
     if (plane.hint == right) { plane.hint = left; }
     put(plane, right);
 
@@ -0,0 +1,138 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoNearest_hpp
+#define centoNearest_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <queue>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * The squared euclidean distance from the point to the closest point of the
+ * rect, or -1 if the rect lies further than limit away along either axis.
+ */
+CENTO_FORCEINLINE i64 distanceSquared(const Rect& rect, const Point& point, const i32 limit)
+{
+    const i64 dx = std::max<i64>({i64(rect.ll.x) - point.x, 0, i64(point.x) - rect.ur.x});
+    const i64 dy = std::max<i64>({i64(rect.ll.y) - point.y, 0, i64(point.y) - rect.ur.y});
+    if ((dx > limit) || (dy > limit)) { return -1; }
+
+    return (dx * dx) + (dy * dy);
+}
+
+namespace detail
+{
+
+    /*
+     * Visit tiles in order of increasing distance from the point, stopping
+     * once no tile lies within maxDist or the callback returns false.
+     *
+     * The search starts from the tile containing the point and grows a
+     * frontier over the stitches.  Any tile within distance d can be reached
+     * through tiles which all lie within d (those crossed by the line to its
+     * closest point) so popping the closest frontier tile each time visits the
+     * tiles in distance order while only ever touching the tiles inside the
+     * current search radius and their immediate neighbours.
+     */
+    template <typename F> requires std::predicate<F&, Tile*, i64>
+    void nearestTiles(const Plane& plane, const Point& point, const i32 maxDist, F&& callback)
+    {
+        Tile* const start = findTileAt(plane, point);
+        if (start == nullptr) { return; }
+
+        const i64 limit = i64(maxDist) * i64(maxDist);
+
+        using Entry = std::pair<i64, Tile*>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+        std::unordered_set<const Tile*>                                     seen;
+
+        auto push = [&](Tile* t)
+        {
+            if (not seen.insert(t).second) { return; }
+
+            const i64 d = distanceSquared(getRect(t), point, maxDist);
+            if ((d < 0) || (d > limit)) { return; }
+
+            frontier.emplace(d, t);
+        };
+
+        push(start);
+        while (not frontier.empty())
+        {
+            const auto [d, t] = frontier.top();
+            frontier.pop();
+
+            if (not std::invoke(callback, t, d)) { return; }
+
+            topTiles(t, push);
+            leftTiles(t, push);
+            bottomTiles(t, push);
+            rightTiles(t, push);
+        }
+    }
+
+}
+
+/*
+ * Find the solid tile closest to the point, within maxDist, returns nullptr if
+ * there is no such tile.  A point inside of a solid tile returns that tile.
+ */
+CENTO_FORCEINLINE Tile* nearestSolid(const Plane& plane, const Point& point, const i32 maxDist)
+{
+    Tile* ret = nullptr;
+    detail::nearestTiles(plane, point, maxDist, [&](Tile* t, i64)
+    {
+        if (isSpace(t)) { return true; }
+
+        ret = t;
+        return false;
+    });
+
+    return ret;
+}
+
+/*
+ * Find up to k solid tiles closest to the point, within maxDist, ordered by
+ * increasing distance.
+ */
+CENTO_FORCEINLINE std::vector<Tile*> kNearestSolid(const Plane& plane,
+                                                   const Point& point,
+                                                   const usize  k,
+                                                   const i32    maxDist)
+{
+    std::vector<Tile*> ret;
+    if (k == 0) { return ret; }
+
+    ret.reserve(k);
+    detail::nearestTiles(plane, point, maxDist, [&](Tile* t, i64)
+    {
+        if (isSpace(t)) { return true; }
+
+        ret.push_back(t);
+        return ret.size() < k;
+    });
+
+    return ret;
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoNearest_hpp
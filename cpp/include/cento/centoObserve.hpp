@@ -0,0 +1,55 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoObserve_hpp
+#define centoObserve_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <utility>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * Watch an area of the plane for changes, after every insertTile or removeTile
+ * which changes something of the given kinds inside of the area the callback
+ * is called once as callback(rect, kinds).  The rect is the bounding box of
+ * those changes clipped to the area.
+ *
+ * The callback must not edit the plane.
+ */
+template <typename F> requires std::invocable<F&, const Rect&, Change>
+CENTO_FORCEINLINE WatchId watch(Plane& plane, const Rect& area, const Change changes, F&& callback)
+{
+    const WatchId id = plane.nextWatch++;
+    plane.watches.push_back(Watch{.id       = id,
+                                  .area     = area,
+                                  .changes  = changes,
+                                  .callback = std::forward<F>(callback)});
+
+    return id;
+}
+
+template <typename F> requires std::invocable<F&, const Rect&, Change>
+CENTO_FORCEINLINE WatchId watch(Plane& plane, const Rect& area, F&& callback)
+{
+    return watch(plane, area, Change::All, std::forward<F>(callback));
+}
+
+CENTO_FORCEINLINE void unwatch(Plane& plane, const WatchId id)
+{
+    std::erase_if(plane.watches, [=](const Watch& w) { return w.id == id; });
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoObserve_hpp
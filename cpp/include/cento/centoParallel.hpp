@@ -0,0 +1,162 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoParallel_hpp
+#define centoParallel_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoDefs.hpp"
+#include "centoMacros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <thread>
+#include <vector>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    CENTO_FORCEINLINE usize workerCount() noexcept
+    {
+        return std::max<usize>(1, std::thread::hardware_concurrency());
+    }
+
+    /*
+     * A value kept by one worker on a cache line of its own, so that workers
+     * updating theirs side by side do not keep taking the line off each other.
+     */
+    template <typename T>
+    struct alignas(64) PerWorker
+    {
+        T value;
+    };
+
+    /*
+     * Split the range [0, count) into chunks of grain items and hand them out
+     * to a set of workers, the body is called as body(worker, begin, end) so
+     * that callers may keep per worker state (for example a search hint).
+     *
+     * Small ranges are run inline on the calling thread as worker 0.
+     */
+    template <typename F> requires std::invocable<F&, usize, usize, usize>
+    void parallelFor(const usize count,
+                     const usize grain,
+                     const usize workers,
+                     F&&         body)
+    {
+        if (count == 0) { return; }
+
+        const usize chunks = (count + grain - 1) / grain;
+        const usize n      = std::min(workers, chunks);
+        if (n <= 1)
+        {
+            body(usize(0), usize(0), count);
+            return;
+        }
+
+        std::atomic<usize> next{0};
+        auto work = [&](const usize worker)
+        {
+            for (usize c = next.fetch_add(1, std::memory_order_relaxed);
+                 c < chunks;
+                 c = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                const usize begin = c * grain;
+                body(worker, begin, std::min(begin + grain, count));
+            }
+        };
+
+        std::vector<std::jthread> threads;
+        threads.reserve(n - 1);
+        for (usize w = 1; w < n; ++w) { threads.emplace_back(work, w); }
+
+        work(usize(0));
+    }
+
+    /*
+     * Run body(worker, i) for each i in [0, count), for items whose cost varies
+     * too much to hand out in fixed chunks.
+     *
+     * Each worker is dealt an even run of the items up front and takes them
+     * from the front of its run one at a time, a worker which runs dry steals
+     * the back half of the run of another.  A run is held as its begin and end
+     * packed in one atomic so that taking and stealing are single CASes.  Only
+     * the owner ever grows its run, and only once it has run dry.
+     */
+    template <typename F> requires std::invocable<F&, usize, usize>
+    void parallelSteal(const usize count, const usize workers, F&& body)
+    {
+        if (count == 0) { return; }
+
+        const usize n = std::min(workers, count);
+        if (n <= 1)
+        {
+            for (usize i = 0; i < count; ++i) { body(usize(0), i); }
+            return;
+        }
+
+        auto pack  = [](const u64 begin, const u64 end) { return begin | (end << 32); };
+        auto begin = [](const u64 run) { return run & 0xFFFFFFFF; };
+        auto end   = [](const u64 run) { return run >> 32; };
+
+        std::vector<std::atomic<u64>> runs(n);
+        for (usize w = 0; w < n; ++w) { runs[w].store(pack(w * count / n, (w + 1) * count / n)); }
+
+        auto work = [&](const usize worker)
+        {
+            std::atomic<u64>& own = runs[worker];
+            for (;;)
+            {
+                u64 run = own.load();
+                while (begin(run) < end(run))
+                {
+                    if (own.compare_exchange_weak(run, pack(begin(run) + 1, end(run))))
+                    {
+                        body(worker, usize(begin(run)));
+                        run = own.load();
+                    }
+                }
+
+                // steal the back half of the first run which still has work
+                bool stolen = false;
+                for (usize v = 1; (v < n) && not stolen; ++v)
+                {
+                    std::atomic<u64>& victim = runs[(worker + v) % n];
+
+                    u64 theirs = victim.load();
+                    while (begin(theirs) < end(theirs))
+                    {
+                        const u64 mid = begin(theirs) + (end(theirs) - begin(theirs)) / 2;
+                        if (victim.compare_exchange_weak(theirs, pack(begin(theirs), mid)))
+                        {
+                            own.store(pack(mid, end(theirs)));
+                            stolen = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (not stolen) { return; }
+            }
+        };
+
+        std::vector<std::jthread> threads;
+        threads.reserve(n - 1);
+        for (usize w = 1; w < n; ++w) { threads.emplace_back(work, w); }
+
+        work(usize(0));
+    }
+
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoParallel_hpp
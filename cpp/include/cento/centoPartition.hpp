@@ -0,0 +1,317 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoPartition_hpp
+#define centoPartition_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoCreate.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoInsert.hpp"
+#include "centoPlane.hpp"
+#include "centoRemove.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * A horizontal band of a partitioned plane, covering [bottom, top).  Each band
+ * is a plane of its own with its own lock.  The left and right edges of each
+ * tile carrying on across the top of the band into the next are kept with it,
+ * under the same lock.
+ */
+struct Band
+{
+    Plane                         plane;
+    i32                           bottom = nInfinity;
+    i32                           top    = pInfinity;
+    std::set<std::pair<i32, i32>> crossing;
+    mutable std::mutex            mutex;
+};
+
+/*
+ * A plane split into horizontal bands at a set of cut lines so that edits in
+ * different bands can run on different threads.
+ *
+ * A tile which crosses a cut is stored as one piece in each band it covers,
+ * and the band below the cut records that it carries on.  Only one tile can
+ * lie across a cut over a given span, so the span alone finds the piece on
+ * the other side, and two tiles of the same body which merely abut at a cut
+ * stay two tiles.
+ *
+ * An edit or query locks every band it touches, always from the bottom band
+ * up, so that edits spanning several bands cannot deadlock.
+ */
+struct PartitionedPlane
+{
+    std::vector<i32> cuts;
+    std::deque<Band> bands;
+};
+
+CENTO_FORCEINLINE void createUniverse(PartitionedPlane& pp, const std::span<const i32> cuts)
+{
+    Expects(std::ranges::adjacent_find(cuts, std::greater_equal<>()) == cuts.end());
+
+    pp.cuts.assign(cuts.begin(), cuts.end());
+    pp.bands.clear();
+    for (usize i = 0; i <= cuts.size(); ++i)
+    {
+        Band& band  = pp.bands.emplace_back();
+        band.bottom = (i == 0)           ? nInfinity : cuts[i - 1];
+        band.top    = (i == cuts.size()) ? pInfinity : cuts[i];
+        createUniverse(band.plane);
+    }
+}
+
+namespace detail
+{
+
+    CENTO_FORCEINLINE usize bandAt(const PartitionedPlane& pp, const i32 y)
+    {
+        return usize(std::ranges::upper_bound(pp.cuts, y) - pp.cuts.begin());
+    }
+
+    // The first and last band overlapped by the rect.
+    CENTO_FORCEINLINE std::pair<usize, usize> bandsOf(const PartitionedPlane& pp, const Rect& r)
+    {
+        return {bandAt(pp, r.ll.y), bandAt(pp, r.ur.y - 1)};
+    }
+
+    CENTO_FORCEINLINE std::vector<std::unique_lock<std::mutex>> lockBands(const PartitionedPlane& pp,
+                                                                          const std::pair<usize, usize> range)
+    {
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(range.second - range.first + 1);
+        for (usize b = range.first; b <= range.second; ++b)
+        {
+            locks.emplace_back(pp.bands[b].mutex);
+        }
+
+        return locks;
+    }
+
+    CENTO_FORCEINLINE Rect clip(const Band& band, const Rect& r)
+    {
+        return {.ll = {.x = r.ll.x, .y = std::max(r.ll.y, band.bottom)},
+                .ur = {.x = r.ur.x, .y = std::min(r.ur.y, band.top)}};
+    }
+
+    CENTO_FORCEINLINE std::pair<i32, i32> spanOf(const Tile* piece)
+    {
+        return {getLeft(piece), getRight(piece)};
+    }
+
+    // Whether the tile of the piece carries on across the top of the band.
+    CENTO_FORCEINLINE bool crossesTop(const PartitionedPlane& pp, const usize band, const Tile* piece)
+    {
+        return isSolid(piece) && (band + 1 < pp.bands.size()) &&
+               (getTop(piece) == pp.bands[band].top) && pp.bands[band].crossing.contains(spanOf(piece));
+    }
+
+    /*
+     * The piece of the same tile in the band below (or above) if the tile
+     * crosses the cut, the caller must hold the lock of that band.
+     */
+    CENTO_FORCEINLINE Tile* pieceBelow(const PartitionedPlane& pp, const usize band, const Tile* piece)
+    {
+        if ((band == 0) || (getBottom(piece) != pp.bands[band].bottom)) { return nullptr; }
+        if (isSpace(piece) || not pp.bands[band - 1].crossing.contains(spanOf(piece))) { return nullptr; }
+
+        return findTileAt(pp.bands[band - 1].plane, {getLeft(piece), getBottom(piece) - 1});
+    }
+
+    CENTO_FORCEINLINE Tile* pieceAbove(const PartitionedPlane& pp, const usize band, const Tile* piece)
+    {
+        if (not crossesTop(pp, band, piece)) { return nullptr; }
+
+        return findTileAt(pp.bands[band + 1].plane, {getLeft(piece), getTop(piece)});
+    }
+
+}
+
+/*
+ * The whole rect of the tile the piece is part of.  This does not lock the
+ * bands so nothing may be editing the bands the tile covers.
+ */
+CENTO_FORCEINLINE Rect getRect(const PartitionedPlane& pp, const Tile* piece)
+{
+    Rect r = getRect(piece);
+    if (isSpace(piece)) { return r; }
+
+    const usize band = detail::bandAt(pp, getBottom(piece));
+
+    usize b = band;
+    for (const Tile* t = piece; (t = detail::pieceBelow(pp, b, t)) != nullptr; --b)
+    {
+        r.ll.y = getBottom(t);
+    }
+
+    b = band;
+    for (const Tile* t = piece; (t = detail::pieceAbove(pp, b, t)) != nullptr; ++b)
+    {
+        r.ur.y = getTop(t);
+    }
+
+    return r;
+}
+
+CENTO_FORCEINLINE Tile* findTileAt(const PartitionedPlane& pp, const Point& point)
+{
+    const Band&      band = pp.bands[detail::bandAt(pp, point.y)];
+    std::scoped_lock lock(band.mutex);
+
+    return findTileAt(band.plane, point);
+}
+
+CENTO_FORCEINLINE bool empty(const PartitionedPlane& pp, const Rect& area)
+{
+    const auto range = detail::bandsOf(pp, area);
+    const auto locks = detail::lockBands(pp, range);
+
+    for (usize b = range.first; b <= range.second; ++b)
+    {
+        const Band& band = pp.bands[b];
+        if (not empty(band.plane, detail::clip(band, area))) { return false; }
+    }
+
+    return true;
+}
+
+/*
+ * Insert a tile, returning its piece in the lowest band it covers or nullptr
+ * if the area is not empty.
+ */
+CENTO_FORCEINLINE Tile* insertTile(PartitionedPlane& pp, const TilePlan& plan)
+{
+    const auto range = detail::bandsOf(pp, plan.rect);
+    const auto locks = detail::lockBands(pp, range);
+
+    for (usize b = range.first; b <= range.second; ++b)
+    {
+        const Band& band = pp.bands[b];
+        if (not empty(band.plane, detail::clip(band, plan.rect))) { return nullptr; }
+    }
+
+    Tile* ret = nullptr;
+    for (usize b = range.first; b <= range.second; ++b)
+    {
+        Band&       band = pp.bands[b];
+        Tile* const t    = insertTile(band.plane, {.id = plan.id, .rect = detail::clip(band, plan.rect)});
+        if (ret == nullptr) { ret = t; }
+
+        if (b < range.second) { band.crossing.emplace(plan.rect.ll.x, plan.rect.ur.x); }
+    }
+
+    return ret;
+}
+
+/*
+ * Remove the tile any one of the given pieces belongs to.
+ */
+CENTO_FORCEINLINE void removeTile(PartitionedPlane& pp, Tile* piece)
+{
+    Expects(not isSpace(piece));
+
+    // Solid tiles never change shape once inserted, so the rect of a piece can
+    // be read without holding the lock of its band.  Find the lowest piece one
+    // band at a time, then lock from there upwards to keep the lock order.
+    usize band = detail::bandAt(pp, getBottom(piece));
+    while (band > 0)
+    {
+        std::scoped_lock lock(pp.bands[band - 1].mutex);
+
+        Tile* const below = detail::pieceBelow(pp, band, piece);
+        if (below == nullptr) { break; }
+
+        piece = below;
+        --band;
+    }
+
+    std::vector<std::unique_lock<std::mutex>> locks;
+    std::vector<std::pair<usize, Tile*>>      pieces;
+
+    locks.emplace_back(pp.bands[band].mutex);
+    while (piece)
+    {
+        pieces.emplace_back(band, piece);
+        if (not detail::crossesTop(pp, band, piece)) { break; }
+
+        locks.emplace_back(pp.bands[band + 1].mutex);
+        Tile* const above = detail::pieceAbove(pp, band, piece);
+        pp.bands[band].crossing.erase(detail::spanOf(piece));
+
+        piece = above;
+        ++band;
+    }
+
+    for (const auto& [b, p] : pieces) { removeTile(pp.bands[b].plane, p); }
+}
+
+namespace detail
+{
+
+    template <bool SolidOnly, typename F> requires std::invocable<F&&, Tile*>
+    CENTO_FORCEINLINE void queryBands(const PartitionedPlane& pp, const Rect& area, F&& callback)
+    {
+        const auto range = bandsOf(pp, area);
+        const auto locks = lockBands(pp, range);
+
+        bool stopped = false;
+        for (usize b = range.first; (b <= range.second) && not stopped; ++b)
+        {
+            const Band& band = pp.bands[b];
+            queryArea<SolidOnly>(band.plane.hint, clip(band, area), [&](Tile* t)
+            {
+                // a tile crossing a cut inside of the area is only reported
+                // through its lowest piece
+                if (SolidOnly && (b > range.first) && pieceBelow(pp, b, t)) { return true; }
+
+                stopped = not report<false>(t, std::forward<F>(callback));
+                return not stopped;
+            });
+        }
+    }
+
+}
+
+/*
+ * Enumerate the tiles of each band within the area, bottom band first.  Every
+ * piece is reported, including the space tiles of each band.
+ */
+template <typename F> requires std::invocable<F&&, Tile*>
+CENTO_FORCEINLINE void query(const PartitionedPlane& pp, const Rect& area, F&& callback)
+{
+    detail::queryBands<false>(pp, area, std::forward<F>(callback));
+}
+
+/*
+ * Enumerate the solid tiles within the area, each tile is reported once through
+ * its lowest piece within the area, use getRect(pp, tile) for its whole rect.
+ */
+template <typename F> requires std::invocable<F&&, Tile*>
+CENTO_FORCEINLINE void querySolid(const PartitionedPlane& pp, const Rect& area, F&& callback)
+{
+    detail::queryBands<true>(pp, area, std::forward<F>(callback));
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoPartition_hpp
@@ -11,31 +11,236 @@
 
 #include "centoNamespace.hpp"
 #include "centoMacros.hpp"
+#include "centoEpoch.hpp"
 #include "centoTile.hpp"
 #include "centoTilePlan.hpp"
 
 #include <mnta/mnta.hpp>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 CENTO_BEGIN_NAMESPACE
 
 constexpr const i32 pInfinity = std::numeric_limits<i32>::max();
 constexpr const i32 nInfinity = std::numeric_limits<i32>::min();
 
+/*
+ * The kinds of change an edit can make to a plane, tiles being split, tiles
+ * being merged and the body of an area changing.
+ */
+enum struct Change : u8
+{
+    None  = 0,
+    Split = 1 << 0,
+    Merge = 1 << 1,
+    Body  = 1 << 2,
+    All   = Split | Merge | Body
+};
+
+CENTO_FORCEINLINE constexpr Change operator|(const Change lhs, const Change rhs) noexcept
+{
+    return Change(u8(lhs) | u8(rhs));
+}
+
+CENTO_FORCEINLINE constexpr Change operator&(const Change lhs, const Change rhs) noexcept
+{
+    return Change(u8(lhs) & u8(rhs));
+}
+
+using WatchId = u32;
+
+/*
+ * A client watching an area of the plane, after each edit the callback is
+ * called once with the bounding rect of the changes it is interested in,
+ * clipped to the watched area, along with the kinds of change seen.
+ */
+struct Watch
+{
+    WatchId                                  id;
+    Rect                                     area;
+    Change                                   changes;
+    std::function<void(const Rect&, Change)> callback;
+};
+
+namespace detail
+{
+
+    // The bounding rect of each kind of change made by the current edit.
+    struct Changes
+    {
+        Change kinds = Change::None;
+        Rect   split = {};
+        Rect   merge = {};
+        Rect   body  = {};
+    };
+
+    /*
+     * The tiles changed while a snapshot was the newest one, each is stored as
+     * it was before the first change.  Tiles freed in that time are kept in the
+     * graveyard so that their memory is not reused under an older snapshot.
+     */
+    struct Generation
+    {
+        std::unordered_map<const Tile*, Tile> images;
+        std::vector<Tile*>                    graveyard;
+        usize                                 readers = 0;
+    };
+
+    /*
+     * The generations of the snapshots taken of a plane, oldest first.  Edits
+     * hold the mutex exclusively and snapshot reads hold it shared.
+     */
+    struct Versions
+    {
+        std::shared_mutex      mutex;
+        std::deque<Generation> generations;
+        u64                    first = 0;
+        std::vector<Tile*>     reclaimed;
+    };
+
+}
+
 struct Plane
 {
-    mutable Tile*              hint  = nullptr;
-    mnta::RecyclingArena<Tile> allocator;
+    mutable Tile*                     hint  = nullptr;
+    mnta::RecyclingArena<Tile>        allocator;
+    std::vector<Watch>                watches;
+    detail::Changes                   changes;
+    WatchId                           nextWatch = 0;
+    std::shared_ptr<detail::Versions> versions;
+    std::unique_ptr<EpochDomain>      epochs;
 
     CENTO_FORCEINLINE friend Tile* get(Plane& plane) noexcept
     {
         return plane.allocator.get();
     }
 
-    CENTO_FORCEINLINE friend void put(Plane& plane, Tile* tile) noexcept
+    CENTO_FORCEINLINE friend void put(Plane& plane, Tile* tile)
+    {
+        if (plane.versions && not plane.versions->generations.empty())
+        {
+            plane.versions->generations.back().graveyard.push_back(tile);
+            return;
+        }
+
+        recycle(plane, tile);
+    }
+
+    /*
+     * Hand a tile which nothing can see any longer back to the allocator, or
+     * retire it until the readers pinned in an older epoch have finished.
+     */
+    CENTO_FORCEINLINE friend void recycle(Plane& plane, Tile* tile)
     {
+        if (plane.epochs)
+        {
+            retire(*plane.epochs, tile);
+            return;
+        }
+
         plane.allocator.put(tile);
     }
+
+    /*
+     * Keep a copy of the tile as it is now before an edit changes it, this is
+     * a no-op unless there is a snapshot of the plane.
+     */
+    CENTO_FORCEINLINE friend void preserve(Plane& plane, const Tile* tile)
+    {
+        if (not plane.versions || plane.versions->generations.empty()) { return; }
+
+        plane.versions->generations.back().images.try_emplace(tile, *tile);
+    }
+
+    /*
+     * Begin an edit of the plane, while there are snapshots this holds off
+     * their reads until the edit is done.  Tiles which no snapshot or pinned
+     * reader can see any longer are handed back to the allocator here, on the
+     * editing thread.
+     */
+    CENTO_FORCEINLINE friend std::unique_lock<std::shared_mutex> lockEdit(Plane& plane)
+    {
+        std::unique_lock<std::shared_mutex> lock;
+        if (plane.versions)
+        {
+            lock = std::unique_lock(plane.versions->mutex);
+            for (Tile* const t : plane.versions->reclaimed) { recycle(plane, t); }
+            plane.versions->reclaimed.clear();
+        }
+
+        if (plane.epochs)
+        {
+            reclaim(*plane.epochs, [&](Tile* t) { plane.allocator.put(t); });
+        }
+
+        return lock;
+    }
+
+    /*
+     * Record a change made by the current edit, this is a no-op unless someone
+     * is watching the plane.
+     *
+     * The tiles split and merged by an edit are mostly strips of space running
+     * far beyond it, so once the edit has recorded the body it changes only
+     * the part of those tiles within that body is recorded.
+     */
+    CENTO_FORCEINLINE friend void record(Plane& plane, const Change kind, const Rect& r)
+    {
+        if (plane.watches.empty()) { return; }
+
+        detail::Changes& c = plane.changes;
+
+        Rect area = r;
+        if ((kind != Change::Body) && ((c.kinds & Change::Body) != Change::None))
+        {
+            if (not overlaps(r, c.body)) { return; }
+            area = intersection(r, c.body);
+        }
+
+        Rect& bounds = (kind == Change::Split) ? c.split :
+                       (kind == Change::Merge) ? c.merge : c.body;
+        bounds       = ((c.kinds & kind) == Change::None) ? area : boundingBox(bounds, area);
+        c.kinds      = c.kinds | kind;
+    }
+
+    /*
+     * Tell each of the watchers about the changes made by the edit which has
+     * just finished, then forget about them ready for the next edit.
+     */
+    CENTO_FORCEINLINE friend void notify(Plane& plane)
+    {
+        const detail::Changes c = plane.changes;
+        plane.changes           = {};
+        if (c.kinds == Change::None) { return; }
+
+        for (const Watch& w : plane.watches)
+        {
+            Change seen   = Change::None;
+            Rect   bounds = {};
+            auto   add    = [&](const Change kind, const Rect& r)
+            {
+                if ((w.changes & c.kinds & kind) == Change::None) { return; }
+                if (not overlaps(r, w.area)) { return; }
+
+                const Rect clipped = intersection(r, w.area);
+                bounds = (seen == Change::None) ? clipped : boundingBox(bounds, clipped);
+                seen   = seen | kind;
+            };
+            add(Change::Split, c.split);
+            add(Change::Merge, c.merge);
+            add(Change::Body, c.body);
+
+            if (seen == Change::None) { continue; }
+
+            w.callback(bounds, seen);
+        }
+    }
 };
 
 CENTO_END_NAMESPACE
@@ -0,0 +1,280 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoPlow_hpp
+#define centoPlow_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoDirection.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoInsert.hpp"
+#include "centoPlane.hpp"
+#include "centoRemove.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    // The span of the rect along the direction of travel, turned around when
+    // travelling left or down so that moving forward always adds.
+    CENTO_FORCEINLINE std::pair<i32, i32> lengthwise(const Rect& r, const Direction dir) noexcept
+    {
+        switch (dir)
+        {
+        case Direction::Right: return {r.ll.x, r.ur.x};
+        case Direction::Left:  return {-r.ur.x, -r.ll.x};
+        case Direction::Up:    return {r.ll.y, r.ur.y};
+        case Direction::Down:  return {-r.ur.y, -r.ll.y};
+        }
+
+        return {};
+    }
+
+    // The span of the rect across the direction of travel.
+    CENTO_FORCEINLINE std::pair<i32, i32> crosswise(const Rect& r, const Direction dir) noexcept
+    {
+        const bool horizontal = (dir == Direction::Left) || (dir == Direction::Right);
+
+        return horizontal ? std::pair{r.ll.y, r.ur.y} : std::pair{r.ll.x, r.ur.x};
+    }
+
+    // Move the rect forward along the direction of travel.
+    CENTO_FORCEINLINE Rect advance(const Rect& r, const Direction dir, const i32 by) noexcept
+    {
+        switch (dir)
+        {
+        case Direction::Right: return translate(r, {by, 0});
+        case Direction::Left:  return translate(r, {-by, 0});
+        case Direction::Up:    return translate(r, {0, by});
+        case Direction::Down:  return translate(r, {0, -by});
+        }
+
+        return r;
+    }
+
+    template <typename F> requires std::invocable<F&, Tile*>
+    CENTO_FORCEINLINE void aheadTiles(const Tile* tile, const Direction dir, F& callback)
+    {
+        auto each = [&](Tile* t) { std::invoke(callback, t); };
+        switch (dir)
+        {
+        case Direction::Right: rightTiles(tile, each); break;
+        case Direction::Left:  leftTiles(tile, each); break;
+        case Direction::Up:    topTiles(tile, each); break;
+        case Direction::Down:  bottomTiles(tile, each); break;
+        }
+    }
+
+    /*
+     * Report each solid tile the tile faces along the direction, that is those
+     * which a line drawn forward from some part of the tile reaches without
+     * crossing anything solid.  The walk goes through the space ahead keeping
+     * only the part of the span which is still unblocked, and stops at tiles
+     * whose leading edge is at or past the limit.
+     */
+    template <typename F> requires std::invocable<F&, Tile*>
+    CENTO_FORCEINLINE void facing(const Tile* tile, const Direction dir, const i64 limit, F&& callback)
+    {
+        const auto [lo, hi] = crosswise(getRect(tile), dir);
+
+        std::vector<std::tuple<const Tile*, i32, i32>> stack = {{tile, lo, hi}};
+        while (not stack.empty())
+        {
+            const auto [t, l, h] = stack.back();
+            stack.pop_back();
+
+            auto visit = [&, l = l, h = h](Tile* n)
+            {
+                if (lengthwise(getRect(n), dir).first >= limit) { return; }
+
+                const auto [nl, nh] = crosswise(getRect(n), dir);
+                const i32 vl = std::max(l, nl);
+                const i32 vh = std::min(h, nh);
+                if (vl >= vh) { return; }
+
+                if (isSolid(n)) { std::invoke(callback, n); }
+                else { stack.push_back({n, vl, vh}); }
+            };
+            aheadTiles(t, dir, visit);
+        }
+    }
+
+}
+
+/*
+ * Plow the edge through the plane by distance, pushing along every solid tile
+ * in its way and everything those tiles then come within spacing(a, b) of,
+ * where a is the id of the pushing tile and b of the one pushed.  No spacing
+ * may be more than maxSpacing, which bounds how far ahead of a moved tile the
+ * plow looks for others to push.
+ *
+ * The edge is a vertical segment (ll.x == ur.x) plowed right, or left for a
+ * negative distance, or a horizontal one (ll.y == ur.y) plowed up or down.  A
+ * tile whose leading edge lies in the swept area is pushed to the far side of
+ * it, one which the edge starts inside is carried the whole distance.
+ *
+ * The solid tiles of one id which touch along their edges make up a shape and
+ * are pushed together, so a shape is never torn apart.  The pushes spread
+ * from each moved shape to the tiles it faces, the shapes being taken in the
+ * order of their leading edges and taken again should a later push grow.  A
+ * pair already closer than their spacing only keep the distance they have, so
+ * a shape reaching around another cannot push it on without end.  The moved
+ * tiles are then lifted out and put back in one batch, so the pointers to
+ * them are no longer valid.  Returns the number of tiles moved.
+ */
+template <typename F> requires std::invocable<F&, u64, u64>
+CENTO_FORCEINLINE usize plow(Plane& plane, const Rect& edge, const i32 distance, F&& spacing, const i32 maxSpacing)
+{
+    const bool vertical = (edge.ll.x == edge.ur.x);
+    Expects(vertical ? (edge.ll.y < edge.ur.y) : ((edge.ll.y == edge.ur.y) && (edge.ll.x < edge.ur.x)));
+    Expects(maxSpacing >= 0);
+
+    if (distance == 0) { return 0; }
+
+    const Direction dir = vertical ? ((distance > 0) ? Direction::Right : Direction::Left)
+                                   : ((distance > 0) ? Direction::Up : Direction::Down);
+    const i32       d   = std::abs(distance);
+
+    // the front of the plow, in the coordinates which grow forward
+    const i32  front = detail::lengthwise(edge, dir).first;
+    const Rect swept = vertical ? Rect{{std::min(edge.ll.x, edge.ll.x + distance), edge.ll.y},
+                                       {std::max(edge.ll.x, edge.ll.x + distance), edge.ur.y}}
+                                : Rect{{edge.ll.x, std::min(edge.ll.y, edge.ll.y + distance)},
+                                       {edge.ur.x, std::max(edge.ll.y, edge.ll.y + distance)}};
+
+    // the shapes reached so far with their leading edges and how far each is
+    // pushed, and those yet to push on in the order of their leading edges
+    std::unordered_map<Tile*, usize> shapeOf;
+    std::vector<std::vector<Tile*>>  shapes;
+    std::vector<i32>                 leads;
+    std::vector<i32>                 pushed;
+    std::vector<bool>                queued;
+    using Entry = std::pair<i32, usize>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> pending;
+
+    auto find = [&](Tile* t) -> usize
+    {
+        if (const auto it = shapeOf.find(t); it != shapeOf.end()) { return it->second; }
+
+        const usize        s       = shapes.size();
+        std::vector<Tile*> members = {t};
+        i32                lead    = detail::lengthwise(getRect(t), dir).first;
+        shapeOf.emplace(t, s);
+
+        auto join = [&](Tile* n)
+        {
+            if (not shapeOf.try_emplace(n, s).second) { return; }
+
+            members.push_back(n);
+            lead = std::min(lead, detail::lengthwise(getRect(n), dir).first);
+        };
+        for (usize i = 0; i < members.size(); ++i) { detail::joinedTiles(members[i], join); }
+
+        shapes.push_back(std::move(members));
+        leads.push_back(lead);
+        pushed.push_back(0);
+        queued.push_back(false);
+
+        return s;
+    };
+
+    auto push = [&](Tile* t, const i32 by)
+    {
+        const usize s = find(t);
+        if (by <= pushed[s]) { return; }
+
+        pushed[s] = by;
+        if (not queued[s])
+        {
+            queued[s] = true;
+            pending.push({leads[s], s});
+        }
+    };
+
+    querySolid(plane, swept, [&](Tile* t)
+    {
+        const i32 lead = detail::lengthwise(getRect(t), dir).first;
+        push(t, (lead < front) ? d : front + d - lead);
+    });
+
+    while (not pending.empty())
+    {
+        const usize s = pending.top().second;
+        pending.pop();
+        queued[s] = false;
+
+        // pushing on may find new shapes, so the members are reached by index
+        const i32 by = pushed[s];
+        for (usize i = 0; i < shapes[s].size(); ++i)
+        {
+            Tile* const a     = shapes[s][i];
+            const i32   trail = detail::lengthwise(getRect(a), dir).second;
+
+            detail::facing(a, dir, i64(trail) + by + maxSpacing, [&](Tile* b)
+            {
+                if (const auto it = shapeOf.find(b); (it != shapeOf.end()) && (it->second == s)) { return; }
+
+                const i32 gap = i32(std::invoke(spacing, a->id, b->id));
+                Expects((gap >= 0) && (gap <= maxSpacing));
+
+                const i32 lead = detail::lengthwise(getRect(b), dir).first;
+                const i32 need = trail + by + std::min(gap, lead - trail) - lead;
+                if (need > 0) { push(b, need); }
+            });
+        }
+    }
+
+    // lift everything out before putting any of it back, a tile may be moving
+    // into the place of another which is itself moving on
+    std::vector<Rect>     lifted;
+    std::vector<TilePlan> moved;
+    for (usize s = 0; s < shapes.size(); ++s)
+    {
+        if (pushed[s] == 0) { continue; }
+
+        for (const Tile* t : shapes[s])
+        {
+            lifted.push_back(getRect(t));
+            moved.push_back({.id = t->id, .rect = detail::advance(getRect(t), dir, pushed[s])});
+        }
+    }
+
+    // removing a tile merges what is left of its shape around it, so each is
+    // found again by its corner, one already taken out with another is space
+    for (const Rect& r : lifted)
+    {
+        if (Tile* const t = findTileAt(plane, r.ll); isSolid(t)) { removeTile(plane, t); }
+    }
+
+    std::ranges::sort(moved, {}, [](const TilePlan& p) { return std::pair{p.rect.ll.y, p.rect.ll.x}; });
+    for (const TilePlan& p : moved)
+    {
+        [[maybe_unused]] Tile* const t = insertTile(plane, p);
+        Ensures(t != nullptr);
+    }
+
+    return moved.size();
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoPlow_hpp
@@ -0,0 +1,256 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoQueue_hpp
+#define centoQueue_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoCreate.hpp"
+#include "centoInsert.hpp"
+#include "centoPlane.hpp"
+#include "centoRemove.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    // An insertion of the plan or, when tile is set, a removal of the tile.
+    struct Edit
+    {
+        TilePlan            plan = {};
+        Tile*               tile = nullptr;
+        Rect                rect = {};
+        std::promise<Tile*> inserted = {};
+        std::promise<void>  removed  = {};
+    };
+
+    // Interleave the bits of the corner so that edits close together in the
+    // plane sort close together.
+    CENTO_FORCEINLINE u64 mortonOf(const Point& p) noexcept
+    {
+        auto spread = [](u64 v)
+        {
+            v = (v | (v << 16)) & 0x0000FFFF0000FFFF;
+            v = (v | (v << 8))  & 0x00FF00FF00FF00FF;
+            v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0F;
+            v = (v | (v << 2))  & 0x3333333333333333;
+            v = (v | (v << 1))  & 0x5555555555555555;
+            return v;
+        };
+
+        // flip the sign bits so negative coordinates sort below positive
+        const u64 x = u32(p.x) ^ 0x80000000;
+        const u64 y = u32(p.y) ^ 0x80000000;
+
+        return spread(x) | (spread(y) << 1);
+    }
+
+    CENTO_FORCEINLINE void apply(Plane& plane, Edit& edit)
+    {
+        try
+        {
+            if (edit.tile == nullptr) { edit.inserted.set_value(insertTile(plane, edit.plan)); }
+            else
+            {
+                removeTile(plane, edit.tile);
+                edit.removed.set_value();
+            }
+        }
+        catch (...)
+        {
+            if (edit.tile == nullptr) { edit.inserted.set_exception(std::current_exception()); }
+            else { edit.removed.set_exception(std::current_exception()); }
+        }
+    }
+
+    /*
+     * Apply a batch of edits in an order which keeps each search for the next
+     * edit close to where the last one finished.  Edits only commute when their
+     * rects do not overlap, so the batch is cut into runs of edits which are
+     * all apart from each other and only each run is sorted.  The rects of the
+     * run so far are kept as tiles in a plane of their own, so an edit ends the
+     * run when its rect cannot be inserted there, and is checked against the
+     * run around it alone rather than every edit in it.
+     */
+    CENTO_FORCEINLINE void applyBatch(Plane& plane, std::vector<Edit>& batch)
+    {
+        Plane taken;
+        createUniverse(taken);
+
+        std::vector<usize> run;
+        std::vector<Tile*> marks;
+        for (usize i = 0; i < batch.size();)
+        {
+            run.clear();
+            for (; i < batch.size(); ++i)
+            {
+                Tile* const mark = insertTile(taken, {.id = 1, .rect = batch[i].rect});
+                if (mark == nullptr) { break; }
+
+                run.push_back(i);
+                marks.push_back(mark);
+            }
+
+            // removing a mark only joins the space around it, the others stay put
+            for (Tile* const mark : marks) { removeTile(taken, mark); }
+            marks.clear();
+
+            std::ranges::sort(run, {}, [&](const usize j) { return mortonOf(batch[j].rect.ll); });
+            for (const usize j : run) { apply(plane, batch[j]); }
+        }
+    }
+
+}
+
+/*
+ * A queue of edits to a plane, pushed by any number of threads and applied by
+ * one thread of its own.
+ *
+ * Each push hands back a future for the result of the edit.  The applier takes
+ * everything queued at once and applies it as a batch, sorted so that each
+ * edit starts searching near where the last one finished.  Edits which overlap
+ * are always applied in the order they were pushed.  A push blocks while the
+ * queue holds capacity edits, so a fast producer cannot run away from the
+ * applier.
+ *
+ * Nothing else may touch the plane while the queue lives, except between a
+ * flush and the next push.  The destructor applies whatever is still queued.
+ */
+class EditQueue
+{
+public:
+    explicit EditQueue(Plane& plane, const usize capacity = 1024)
+        : plane_(plane)
+        , capacity_(capacity)
+        , applier_([this] { run(); })
+    {
+        Expects(capacity > 0);
+    }
+
+    EditQueue(const EditQueue&)            = delete;
+    EditQueue& operator=(const EditQueue&) = delete;
+
+    ~EditQueue()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_one();
+        applier_.join();
+    }
+
+    friend std::future<Tile*> insertTile(EditQueue& queue, const TilePlan& plan);
+    friend std::future<void> removeTile(EditQueue& queue, Tile* tile);
+    friend void flush(EditQueue& queue);
+
+private:
+    void push(detail::Edit&& edit)
+    {
+        {
+            std::unique_lock lock(mutex_);
+            space_.wait(lock, [&] { return pending_.size() < capacity_; });
+            pending_.push_back(std::move(edit));
+            ++pushed_;
+        }
+        ready_.notify_one();
+    }
+
+    void run()
+    {
+        std::vector<detail::Edit> batch;
+        for (;;)
+        {
+            {
+                std::unique_lock lock(mutex_);
+                ready_.wait(lock, [&] { return stopping_ || not pending_.empty(); });
+                if (pending_.empty()) { return; }
+
+                batch.swap(pending_);
+            }
+            space_.notify_all();
+
+            detail::applyBatch(plane_, batch);
+
+            {
+                std::lock_guard lock(mutex_);
+                applied_ += batch.size();
+            }
+            drained_.notify_all();
+
+            batch.clear();
+        }
+    }
+
+    Plane&                    plane_;
+    usize                     capacity_;
+    std::vector<detail::Edit> pending_;
+    u64                       pushed_   = 0;
+    u64                       applied_  = 0;
+    bool                      stopping_ = false;
+    std::mutex                mutex_;
+    std::condition_variable   ready_;
+    std::condition_variable   space_;
+    std::condition_variable   drained_;
+    std::thread               applier_;
+};
+
+/*
+ * Queue the insertion of a tile, the future holds the new tile or nullptr
+ * if the area was not empty by the time the edit was applied.
+ */
+CENTO_FORCEINLINE std::future<Tile*> insertTile(EditQueue& queue, const TilePlan& plan)
+{
+    detail::Edit edit{.plan = plan, .rect = plan.rect};
+    std::future<Tile*> result = edit.inserted.get_future();
+    queue.push(std::move(edit));
+
+    return result;
+}
+
+/*
+ * Queue the removal of a solid tile, the tile must still be in the plane
+ * when the edit is applied.
+ */
+CENTO_FORCEINLINE std::future<void> removeTile(EditQueue& queue, Tile* tile)
+{
+    Expects(not isSpace(tile));
+
+    // the rect of a solid tile never changes so it is safe to read here
+    detail::Edit edit{.tile = tile, .rect = getRect(tile)};
+    std::future<void> result = edit.removed.get_future();
+    queue.push(std::move(edit));
+
+    return result;
+}
+
+/*
+ * Wait until every edit pushed before the call has been applied.
+ */
+CENTO_FORCEINLINE void flush(EditQueue& queue)
+{
+    std::unique_lock lock(queue.mutex_);
+    const u64        target = queue.pushed_;
+    queue.drained_.wait(lock, [&] { return queue.applied_ >= target; });
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoQueue_hpp
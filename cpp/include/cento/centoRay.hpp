@@ -0,0 +1,162 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoRay_hpp
+#define centoRay_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoDirection.hpp"
+#include "centoFind.hpp"
+#include "centoParallel.hpp"
+#include "centoPlane.hpp"
+
+#include <span>
+#include <vector>
+
+CENTO_BEGIN_NAMESPACE
+
+struct Ray
+{
+    Point     origin;
+    Direction direction;
+    i32       limit;
+};
+
+/*
+ * The first solid tile hit by a ray, hit is the point on the edge of the tile
+ * where the ray entered it and distance is how far the ray travelled to reach
+ * it.  A ray starting inside of a solid tile hits it at its origin.
+ */
+struct RayHit
+{
+    Tile* tile;
+    Point hit;
+    i32   distance;
+
+    CENTO_FORCEINLINE explicit operator bool() const noexcept
+    {
+        return tile != nullptr;
+    }
+};
+
+namespace detail
+{
+
+    /*
+     * Step from a tile to the tile beyond the edge that the ray leaves it by,
+     * by following the corner stitch on that side and then walking along the
+     * neighbouring tiles until finding the one which contains the ray.  The
+     * coordinate of the edge crossed is returned through edge.
+     */
+    CENTO_FORCEINLINE Tile* stepRay(const Tile*     t,
+                                    const Point&    origin,
+                                    const Direction direction,
+                                    i32&            edge)
+    {
+        Tile* n = nullptr;
+        switch (direction)
+        {
+        case Direction::Left:
+            edge = getLeft(t);
+            for (n = bottomLeft(t); n && (getTop(n) <= origin.y); n = rightTop(n)) {}
+            break;
+        case Direction::Right:
+            edge = getRight(t);
+            for (n = topRight(t); n && (getBottom(n) > origin.y); n = leftBottom(n)) {}
+            break;
+        case Direction::Down:
+            edge = getBottom(t);
+            for (n = leftBottom(t); n && (getRight(n) <= origin.x); n = topRight(n)) {}
+            break;
+        case Direction::Up:
+            edge = getTop(t);
+            for (n = rightTop(t); n && (getLeft(n) > origin.x); n = bottomLeft(n)) {}
+            break;
+        }
+
+        return n;
+    }
+
+    CENTO_FORCEINLINE RayHit castRay(Tile*& hint, const Ray& ray)
+    {
+        Tile* t = locate(hint, ray.origin);
+        if (t == nullptr) { return {}; }
+
+        if (isSolid(t))
+        {
+            return RayHit{.tile = t, .hit = ray.origin, .distance = 0};
+        }
+
+        const bool horizontal = (ray.direction == Direction::Left) ||
+                                (ray.direction == Direction::Right);
+        const i32  start      = horizontal ? ray.origin.x : ray.origin.y;
+
+        while (true)
+        {
+            i32   edge = 0;
+            Tile* n    = stepRay(t, ray.origin, ray.direction, edge);
+            if (n == nullptr) { return {}; }
+
+            const i64 distance = (edge > start) ? (i64(edge) - start) : (i64(start) - edge);
+            if (distance > ray.limit) { return {}; }
+
+            if (isSolid(n))
+            {
+                const Point hit = horizontal ? Point{edge, ray.origin.y}
+                                             : Point{ray.origin.x, edge};
+                return RayHit{.tile = n, .hit = hit, .distance = i32(distance)};
+            }
+
+            t = n;
+        }
+    }
+
+}
+
+/*
+ * Walk from the point in the given direction across the stitches until a solid
+ * tile is hit, or the ray has travelled further than limit.
+ */
+CENTO_FORCEINLINE RayHit castRay(const Plane&    plane,
+                                 const Point&    origin,
+                                 const Direction direction,
+                                 const i32       limit)
+{
+    return detail::castRay(plane.hint,
+                           Ray{.origin = origin, .direction = direction, .limit = limit});
+}
+
+/*
+ * Cast many rays, each worker keeps its own hint so nearby rays are cheap to
+ * locate and the plane itself is never written.  The plane must not be
+ * modified while the rays are being cast.
+ */
+CENTO_FORCEINLINE std::vector<RayHit> castRays(const Plane& plane, const std::span<const Ray> rays)
+{
+    std::vector<RayHit> hits(rays.size());
+
+    const usize                           workers = detail::workerCount();
+    std::vector<detail::PerWorker<Tile*>> hints(workers, {plane.hint});
+
+    detail::parallelFor(rays.size(), 256, workers, [&](usize worker, usize begin, usize end)
+    {
+        Tile* hint = hints[worker].value;
+        for (usize i = begin; i < end; ++i)
+        {
+            hits[i] = detail::castRay(hint, rays[i]);
+        }
+        hints[worker].value = hint;
+    });
+
+    return hits;
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoRay_hpp
@@ -13,6 +13,7 @@
 #include "centoMacros.hpp"
 #include "centoPoint.hpp"
 
+#include <algorithm>
 #include <compare>
 
 CENTO_BEGIN_NAMESPACE
@@ -47,6 +48,24 @@ CENTO_FORCEINLINE Rect translate(const Rect& rect, const Point& delta)
     return { .ll = translate(rect.ll, delta), .ur = translate(rect.ur, delta)};
 }
 
+CENTO_FORCEINLINE bool overlaps(const Rect& lhs, const Rect& rhs)
+{
+    return (lhs.ll.x < rhs.ur.x) && (rhs.ll.x < lhs.ur.x) &&
+           (lhs.ll.y < rhs.ur.y) && (rhs.ll.y < lhs.ur.y);
+}
+
+CENTO_FORCEINLINE Rect intersection(const Rect& lhs, const Rect& rhs)
+{
+    return {.ll = {.x = std::max(lhs.ll.x, rhs.ll.x), .y = std::max(lhs.ll.y, rhs.ll.y)},
+            .ur = {.x = std::min(lhs.ur.x, rhs.ur.x), .y = std::min(lhs.ur.y, rhs.ur.y)}};
+}
+
+CENTO_FORCEINLINE Rect boundingBox(const Rect& lhs, const Rect& rhs)
+{
+    return {.ll = {.x = std::min(lhs.ll.x, rhs.ll.x), .y = std::min(lhs.ll.y, rhs.ll.y)},
+            .ur = {.x = std::max(lhs.ur.x, rhs.ur.x), .y = std::max(lhs.ur.y, rhs.ur.y)}};
+}
+
 CENTO_END_NAMESPACE
 
 #endif // centoRect_hpp
@@ -71,13 +71,18 @@ CENTO_FORCEINLINE void removeTile(Plane& plane, Tile* tile)
 {
     Expects(not isSpace(tile));
 
+    const auto lock = lockEdit(plane);
+
     // 1. Change the type of the deleted tile from solid to space.
+    preserve(plane, tile);
     tile->id = cento::Space;
 
     const Rect box       = getRect(tile);
     const i32  delBottom = box.ll.y;
     const i32  delTop    = box.ur.y;
 
+    record(plane, Change::Body, box);
+
     Tile* leftStart  = bottomLeft(tile);
     Tile* rightStart = topRight(tile);
 
@@ -88,6 +93,13 @@ CENTO_FORCEINLINE void removeTile(Plane& plane, Tile* tile)
         rightStart = splitTileHorz(plane, rightStart, delTop).lower;
     }
 
+    //    Likewise if it reaches below the delete tile, otherwise the loop below
+    //    takes it as a tile along the right edge and never merges with it.
+    if (isSpace(rightStart) && (getBottom(rightStart) < delBottom))
+    {
+        rightStart = splitTileHorz(plane, rightStart, delBottom).upper;
+    }
+
     // 3. Loop through the tiles along the right edge, split the deleted tile
     //    along the bottom edge of the right tile.
     //    Then look to merge the newly split tile to the right.
@@ -125,14 +137,25 @@ CENTO_FORCEINLINE void removeTile(Plane& plane, Tile* tile)
         leftStart = splitTileHorz(plane, leftStart, delBottom).upper;
     }
 
+    //    Likewise if the upper left tile is taller than the deleted tile, else
+    //    the loops below never reach it and it is left unmerged.
+    Tile* leftEnd = leftStart;
+    while (getTop(leftEnd) < delTop) { leftEnd = rightTop(leftEnd); }
+    if (isSpace(leftEnd) && (getTop(leftEnd) > delTop))
+    {
+        splitTileHorz(plane, leftEnd, delTop);
+    }
+
     // 7. Loop through all of the left tiles of the deleted tile and split the
     //    deleted tile wherever there is not already a edge for the top edge.
     //    Then also split the left tile wherever there is a split in the deleted
-    //    tile from the right tiles.
+    //    tile from the right tiles.  The first left tile may reach above the
+    //    deleted tile, the tile to its top right is then not the deleted tile
+    //    and must be left alone.
     auto lSplit = [&](Tile* t)
     {
         Tile* right = topRight(t);
-        if (getTop(t) < getTop(right))
+        if ((getTop(t) < delTop) && (getTop(t) < getTop(right)))
         {
             splitTileHorz(plane, right, getTop(t));
         }
@@ -166,6 +189,8 @@ CENTO_FORCEINLINE void removeTile(Plane& plane, Tile* tile)
 
     // 10. Finally try to merge the left top tile down.
     mergeDown(plane, lt);
+
+    notify(plane);
 }
 
 CENTO_END_NAMESPACE
@@ -0,0 +1,280 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoRoute_hpp
+#define centoRoute_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoCreate.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoInsert.hpp"
+#include "centoPlane.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    CENTO_FORCEINLINE i64 manhattan(const Point& a, const Point& b) noexcept
+    {
+        return std::abs(i64(a.x) - i64(b.x)) + std::abs(i64(a.y) - i64(b.y));
+    }
+
+    // The area a wire of the width takes up along the segment, which runs from
+    // the lower left corner of the wire at a to that at b.
+    CENTO_FORCEINLINE Rect wireRect(const Point& a, const Point& b, const i32 width) noexcept
+    {
+        return {{std::min(a.x, b.x), std::min(a.y, b.y)}, {std::max(a.x, b.x) + width, std::max(a.y, b.y) + width}};
+    }
+
+    // Fill the free parts of the area with tiles of the id.
+    CENTO_FORCEINLINE void paint(Plane& plane, const Rect& area, const u64 id)
+    {
+        std::vector<Rect> free;
+        query(plane, area, [&](Tile* t)
+        {
+            if (isSpace(t)) { free.push_back(intersection(getRect(t), area)); }
+        });
+
+        for (const Rect& r : free) { insertTile(plane, {.id = id, .rect = r}); }
+    }
+
+    /*
+     * The plane of places the lower left corner of a wire of the width may be,
+     * every solid tile grown down and left by the width less one so a wire
+     * whose corner is in space touches nothing solid.
+     */
+    CENTO_FORCEINLINE void blockages(const Plane& plane, Plane& out, const i32 width)
+    {
+        std::vector<Rect> grown;
+        queryAll(plane, [&](Tile* t)
+        {
+            if (isSpace(t)) { return; }
+
+            const Rect r = getRect(t);
+            Expects((r.ll.x != nInfinity) && (r.ll.y != nInfinity));
+
+            grown.push_back({{r.ll.x - width + 1, r.ll.y - width + 1}, r.ur});
+        });
+        std::ranges::sort(grown, {}, [](const Rect& r) { return std::pair{r.ll.y, r.ll.x}; });
+
+        createUniverse(out);
+        for (const Rect& r : grown) { paint(out, r, 0); }
+    }
+
+    // Step from a tile into one beside it, from the point p to the nearest
+    // point inside the neighbour.
+    CENTO_FORCEINLINE Point entry(const Tile* from, const Tile* to, const Point& p) noexcept
+    {
+        auto clamp = [](const i32 v, const i32 lo, const i32 hi) { return std::clamp(v, lo, hi - 1); };
+
+        const i32 xlo = std::max(getLeft(from), getLeft(to));
+        const i32 xhi = std::min(getRight(from), getRight(to));
+        const i32 ylo = std::max(getBottom(from), getBottom(to));
+        const i32 yhi = std::min(getTop(from), getTop(to));
+
+        if (getLeft(to) == getRight(from)) { return {getLeft(to), clamp(p.y, ylo, yhi)}; }
+        if (getRight(to) == getLeft(from)) { return {getRight(to) - 1, clamp(p.y, ylo, yhi)}; }
+        if (getBottom(to) == getTop(from)) { return {clamp(p.x, xlo, xhi), getBottom(to)}; }
+
+        return {clamp(p.x, xlo, xhi), getTop(to) - 1};
+    }
+
+    /*
+     * A* through the space tiles of the plane from one point to another.  Each
+     * tile is entered at the point of the shared edge nearest to where the
+     * last tile was entered, costs are the rectilinear distances between those
+     * points and the estimate the rectilinear distance left to the end.
+     */
+    CENTO_FORCEINLINE std::vector<Point> searchTiles(const Plane& plane, const Point& from, const Point& to)
+    {
+        Tile* const start = findTileAt(plane, from);
+        Tile* const end   = findTileAt(plane, to);
+        if (isSolid(start) || isSolid(end)) { return {}; }
+
+        struct Reached
+        {
+            i64         cost   = 0;
+            Point       at     = {};
+            const Tile* parent = nullptr;
+        };
+        std::unordered_map<const Tile*, Reached> reached;
+
+        using Entry = std::tuple<i64, i64, const Tile*>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+
+        reached[start] = {.cost = 0, .at = from, .parent = nullptr};
+        open.push({manhattan(from, to), 0, start});
+        while (not open.empty())
+        {
+            const auto [estimate, cost, t] = open.top();
+            open.pop();
+
+            const Reached here = reached.at(t);
+            if (cost > here.cost) { continue; }
+            if (t == end) { break; }
+
+            auto visit = [&, t = t](Tile* n)
+            {
+                if (isSolid(n)) { return; }
+
+                const Point at    = entry(t, n, here.at);
+                const i64   reach = here.cost + manhattan(here.at, at);
+
+                const auto [it, added] = reached.try_emplace(n, Reached{.cost = reach, .at = at, .parent = t});
+                if (not added)
+                {
+                    if (reach >= it->second.cost) { return; }
+                    it->second = {.cost = reach, .at = at, .parent = t};
+                }
+
+                open.push({reach + manhattan(at, to), reach, n});
+            };
+            topTiles(t, visit);
+            leftTiles(t, visit);
+            bottomTiles(t, visit);
+            rightTiles(t, visit);
+        }
+
+        if (not reached.contains(end)) { return {}; }
+
+        std::vector<const Tile*> chain;
+        for (const Tile* t = end; t != nullptr; t = reached.at(t).parent) { chain.push_back(t); }
+        std::ranges::reverse(chain);
+
+        // turn a corner inside each tile before stepping over into the next,
+        // so that every leg of the path stays inside a single tile
+        std::vector<Point> path = {from};
+        for (usize i = 1; i < chain.size(); ++i)
+        {
+            const Tile* prev = chain[i - 1];
+            const Tile* next = chain[i];
+            const Point p    = path.back();
+            const Point q    = reached.at(next).at;
+
+            const bool across = (getLeft(next) == getRight(prev)) || (getRight(next) == getLeft(prev));
+            path.push_back(across ? Point{p.x, q.y} : Point{q.x, p.y});
+            path.push_back(q);
+        }
+        path.push_back({path.back().x, to.y});
+        path.push_back(to);
+
+        return path;
+    }
+
+    // Drop the repeated points and those partway along a straight leg.
+    CENTO_FORCEINLINE void simplify(std::vector<Point>& path)
+    {
+        std::vector<Point> kept;
+        for (const Point& p : path)
+        {
+            if (not kept.empty() && (kept.back() == p)) { continue; }
+
+            if (kept.size() >= 2)
+            {
+                const Point& a = kept[kept.size() - 2];
+                const Point& b = kept.back();
+                if (((a.x == b.x) && (b.x == p.x)) || ((a.y == b.y) && (b.y == p.y))) { kept.back() = p; continue; }
+            }
+
+            kept.push_back(p);
+        }
+
+        path = std::move(kept);
+    }
+
+}
+
+/*
+ * Build into out, which must be empty, the plane of places the lower left
+ * corner of a wire of the width may be, every solid tile of the plane being
+ * grown down and left by the width less one.  Routing a wire of width one
+ * through it with routePath is the same as routing a wire of the width
+ * through the plane, so it can be built once for as many wires as wanted.
+ * It is not kept up to date, and must be built again after the plane is
+ * edited.
+ */
+CENTO_FORCEINLINE void wirePlane(const Plane& plane, Plane& out, const i32 wireWidth)
+{
+    Expects((wireWidth > 0) && (out.hint == nullptr));
+
+    detail::blockages(plane, out, wireWidth);
+}
+
+/*
+ * Route a wire of the width from one point to another through the space of
+ * the plane, returning the corners of a rectilinear path from the first point
+ * to the last, or nothing if there is no way through.  The points are of the
+ * lower left corner of the wire, the wire being a square of the width swept
+ * along the path.
+ *
+ * The search is A* over the space tiles rather than a grid, each tile being
+ * entered at the nearest point of its edge with the last and the neighbours
+ * found through the stitches, so the path is short though not always the
+ * shortest.  A wire wider than one is routed through a plane of the solid
+ * tiles grown by the width, which is built from the whole plane each call,
+ * to route many wires of one width build that plane once with wirePlane.
+ */
+CENTO_FORCEINLINE std::vector<Point> routePath(const Plane& plane, const Point& from, const Point& to, const i32 wireWidth)
+{
+    Expects(wireWidth > 0);
+
+    std::vector<Point> path;
+    if (wireWidth == 1) { path = detail::searchTiles(plane, from, to); }
+    else
+    {
+        Plane grown;
+        detail::blockages(plane, grown, wireWidth);
+        path = detail::searchTiles(grown, from, to);
+    }
+    detail::simplify(path);
+
+    return path;
+}
+
+/*
+ * Put the wire along a path found by routePath into the plane as tiles of the
+ * id, the legs of the wire being painted in bottom up in one batch.  Returns
+ * false, leaving the plane as it was, if the wire would cross a solid tile.
+ */
+CENTO_FORCEINLINE bool commitPath(Plane& plane, const std::span<const Point> path, const i32 wireWidth, const u64 id)
+{
+    Expects((wireWidth > 0) && (id != Space));
+
+    std::vector<Rect> legs;
+    for (usize i = 1; i < path.size(); ++i)
+    {
+        Expects((path[i - 1].x == path[i].x) || (path[i - 1].y == path[i].y));
+        legs.push_back(detail::wireRect(path[i - 1], path[i], wireWidth));
+    }
+    if (path.size() == 1) { legs.push_back(detail::wireRect(path.front(), path.front(), wireWidth)); }
+
+    if (std::ranges::any_of(legs, [&](const Rect& r) { return anySolid(plane, r); })) { return false; }
+
+    std::ranges::sort(legs, {}, [](const Rect& r) { return std::pair{r.ll.y, r.ll.x}; });
+    for (const Rect& r : legs) { detail::paint(plane, r, id); }
+
+    return true;
+}
+
+
+CENTO_END_NAMESPACE
+
+#endif // centoRoute_hpp
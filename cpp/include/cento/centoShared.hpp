@@ -0,0 +1,154 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoShared_hpp
+#define centoShared_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoEpoch.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoPlane.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * A read only view of a plane with its own search hint.
+ *
+ * Searching through a plane moves the planes hint, so even const searches
+ * write to the plane.  A reader keeps its hint to itself instead, any number of
+ * readers may search the same plane at once as long as nothing is editing it.
+ */
+struct PlaneReader
+{
+    const Plane* plane = nullptr;
+    Tile*        hint  = nullptr;
+
+    explicit PlaneReader(const Plane& p) noexcept : plane(&p), hint(p.hint) { }
+};
+
+CENTO_FORCEINLINE Tile* findTileAt(PlaneReader& reader, const Point& point)
+{
+    return detail::locate(reader.hint, point);
+}
+
+CENTO_FORCEINLINE bool empty(PlaneReader& reader, const Rect& area)
+{
+    return detail::emptyArea(reader.hint, area);
+}
+
+template <typename F> requires std::invocable<F&&, Tile*>
+CENTO_FORCEINLINE void query(PlaneReader& reader, const Rect& area, F&& callback)
+{
+    detail::queryArea<false>(reader.hint, area, std::forward<F>(callback));
+}
+
+template <typename F> requires std::invocable<F&&, Tile*>
+CENTO_FORCEINLINE void querySolid(PlaneReader& reader, const Rect& area, F&& callback)
+{
+    detail::queryArea<true>(reader.hint, area, std::forward<F>(callback));
+}
+
+/*
+ * A plane guarded by a reader/writer lock.
+ *
+ * Readers are handed a PlaneReader while holding the lock shared, so they never
+ * touch the planes hint and may run alongside each other.  A writer holds the
+ * lock exclusively and is handed the plane itself.  Tiles must not be used
+ * once the callback has returned as a later writer may free them.
+ *
+ * A waiting writer holds the gate, and while any writer is waiting readers
+ * pass through the gate before taking the shared lock, so a steady stream of
+ * readers cannot starve it (the shared mutex alone prefers readers on some
+ * platforms).  With no writer waiting readers go straight to the shared lock
+ * and do not queue up behind each other on the gate.
+ */
+struct SharedPlane
+{
+    Plane                     plane;
+    mutable std::shared_mutex mutex;
+    mutable std::mutex        gate;
+    std::atomic<u32>          writers = 0;
+};
+
+template <typename F> requires std::invocable<F&&, PlaneReader&>
+CENTO_FORCEINLINE decltype(auto) read(const SharedPlane& shared, F&& callback)
+{
+    std::shared_lock<std::shared_mutex> lock;
+    if (shared.writers.load(std::memory_order_acquire) == 0) { lock = std::shared_lock(shared.mutex); }
+    else
+    {
+        std::unique_lock gate(shared.gate);
+        lock = std::shared_lock(shared.mutex);
+    }
+
+    PlaneReader reader(shared.plane);
+
+    return std::invoke(std::forward<F>(callback), reader);
+}
+
+template <typename F> requires std::invocable<F&&, Plane&>
+CENTO_FORCEINLINE decltype(auto) write(SharedPlane& shared, F&& callback)
+{
+    shared.writers.fetch_add(1, std::memory_order_acq_rel);
+
+    std::unique_lock gate(shared.gate);
+    std::unique_lock lock(shared.mutex);
+    gate.unlock();
+
+    shared.writers.fetch_sub(1, std::memory_order_acq_rel);
+
+    return std::invoke(std::forward<F>(callback), shared.plane);
+}
+
+/*
+ * Defer the reuse of the tiles freed by edits until no pinned reader can see
+ * them, this must be called before any reader pins the plane.
+ */
+CENTO_FORCEINLINE void enableEpochs(Plane& plane)
+{
+    if (not plane.epochs) { plane.epochs = std::make_unique<EpochDomain>(); }
+}
+
+/*
+ * Pin the current epoch of the plane, no tile the reader has seen is recycled
+ * while the guard lives.  This does not make reading the plane during an edit
+ * safe, see EpochDomain.  The plane must have had enableEpochs called on it,
+ * it cannot be done here as readers may pin from several threads at once.
+ */
+CENTO_FORCEINLINE EpochGuard pin(const Plane& plane)
+{
+    Expects(plane.epochs != nullptr);
+
+    return EpochGuard(*plane.epochs);
+}
+
+/*
+ * Recycle the retired tiles no pinned reader can see, edits do this as they
+ * start but a writer which has gone quiet may call it itself.
+ */
+CENTO_FORCEINLINE void reclaim(Plane& plane)
+{
+    if (not plane.epochs) { return; }
+
+    reclaim(*plane.epochs, [&](Tile* t) { plane.allocator.put(t); });
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoShared_hpp
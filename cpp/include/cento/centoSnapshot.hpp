@@ -0,0 +1,186 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoSnapshot_hpp
+#define centoSnapshot_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoPlane.hpp"
+
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    /*
+     * Reads a tile as it was when a snapshot was taken.  The first image of
+     * the tile kept since then is what it looked like, if there is none the
+     * tile has not been changed.
+     */
+    struct Past
+    {
+        const Versions* versions;
+        usize           generation;
+
+        CENTO_FORCEINLINE const Tile* operator()(const Tile* tile) const
+        {
+            for (usize i = generation; i < versions->generations.size(); ++i)
+            {
+                const auto& images = versions->generations[i].images;
+                if (const auto it = images.find(tile); it != images.end())
+                {
+                    return &it->second;
+                }
+            }
+
+            return tile;
+        }
+    };
+
+}
+
+/*
+ * A read only view of a plane as it was when the snapshot was taken, which
+ * stays the same while the plane goes on being edited through insertTile and
+ * removeTile.
+ *
+ * Tiles are copied the first time they are changed after the snapshot and
+ * freed tiles are not reused, so a snapshot costs nothing until the plane is
+ * edited.  Those copies are thrown away once the last snapshot which can see
+ * them is dropped, and the freed tiles go back to the plane on its next edit.
+ *
+ * Reads through a snapshot may run on another thread to the edits, each read
+ * waits for the edit in progress (if any) to finish.  A snapshot keeps its own
+ * search hint so each thread should use its own copy.
+ */
+struct Snapshot
+{
+    std::shared_ptr<detail::Versions> versions;
+    u64                               number = 0;
+    Tile*                             hint   = nullptr;
+
+    Snapshot() = default;
+
+    Snapshot(std::shared_ptr<detail::Versions> v, const u64 n, Tile* h) noexcept :
+        versions(std::move(v)), number(n), hint(h)
+    {
+    }
+
+    Snapshot(const Snapshot& other) :
+        versions(other.versions), number(other.number), hint(other.hint)
+    {
+        if (not versions) { return; }
+
+        std::unique_lock lock(versions->mutex);
+        ++versions->generations[usize(number - versions->first)].readers;
+    }
+
+    Snapshot(Snapshot&& other) noexcept :
+        versions(std::move(other.versions)), number(other.number), hint(other.hint)
+    {
+    }
+
+    Snapshot& operator=(Snapshot other) noexcept
+    {
+        std::swap(versions, other.versions);
+        std::swap(number, other.number);
+        std::swap(hint, other.hint);
+
+        return *this;
+    }
+
+    ~Snapshot()
+    {
+        if (not versions) { return; }
+
+        std::unique_lock lock(versions->mutex);
+        --versions->generations[usize(number - versions->first)].readers;
+
+        // Only the oldest generations can be dropped, a newer one still holds
+        // the images of tiles an older snapshot sees.
+        while (not versions->generations.empty() && (versions->generations.front().readers == 0))
+        {
+            detail::Generation& g = versions->generations.front();
+            versions->reclaimed.insert(versions->reclaimed.end(), g.graveyard.begin(), g.graveyard.end());
+            versions->generations.pop_front();
+            ++versions->first;
+        }
+    }
+
+    CENTO_FORCEINLINE friend detail::Past past(const Snapshot& snap) noexcept
+    {
+        return {snap.versions.get(), usize(snap.number - snap.versions->first)};
+    }
+};
+
+/*
+ * Take a snapshot of the plane, this must not be called during an edit.
+ */
+CENTO_FORCEINLINE Snapshot snapshot(Plane& plane)
+{
+    if (not plane.versions) { plane.versions = std::make_shared<detail::Versions>(); }
+
+    detail::Versions& v = *plane.versions;
+    std::unique_lock  lock(v.mutex);
+
+    v.generations.emplace_back().readers = 1;
+
+    return Snapshot(plane.versions, v.first + v.generations.size() - 1, plane.hint);
+}
+
+/*
+ * Find the tile at the point as it was when the snapshot was taken, the tile
+ * is returned by value as the plane may have moved on since.
+ */
+CENTO_FORCEINLINE Tile findTileAt(Snapshot& snap, const Point& point)
+{
+    std::shared_lock lock(snap.versions->mutex);
+
+    return *past(snap)(detail::locate(snap.hint, point, past(snap)));
+}
+
+CENTO_FORCEINLINE bool empty(Snapshot& snap, const Rect& area)
+{
+    std::shared_lock lock(snap.versions->mutex);
+
+    return detail::emptyArea(snap.hint, area, past(snap));
+}
+
+/*
+ * Enumerate the tiles of the snapshot within the area, the callback is called
+ * with the tile as it was when the snapshot was taken and the pointer is only
+ * valid during the call.  Edits of the plane wait for the query to finish.
+ */
+template <typename F> requires std::invocable<F&&, const Tile*>
+CENTO_FORCEINLINE void query(Snapshot& snap, const Rect& area, F&& callback)
+{
+    std::shared_lock lock(snap.versions->mutex);
+
+    detail::queryArea<false>(snap.hint, area, std::forward<F>(callback), past(snap));
+}
+
+template <typename F> requires std::invocable<F&&, const Tile*>
+CENTO_FORCEINLINE void querySolid(Snapshot& snap, const Rect& area, F&& callback)
+{
+    std::shared_lock lock(snap.versions->mutex);
+
+    detail::queryArea<true>(snap.hint, area, std::forward<F>(callback), past(snap));
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoSnapshot_hpp
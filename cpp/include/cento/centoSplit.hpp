@@ -32,6 +32,9 @@ CENTO_FORCEINLINE HorzSplit splitTileHorz(Plane& plane, Tile* tile, const i32 y)
     if (lowerLeft(r).y >= y) { return {}; }
     if (upperRight(r).y <= y) { return {}; }
 
+    record(plane, Change::Split, r);
+    preserve(plane, tile);
+
     Tile* const upper = get(plane);
     Tile* const lower = tile;
 
@@ -50,12 +53,18 @@ CENTO_FORCEINLINE HorzSplit splitTileHorz(Plane& plane, Tile* tile, const i32 y)
 
     // adjust corner stitches along top edge
     for (tp = rightTop(lower); tp && leftBottom(tp) == lower; tp = bottomLeft(tp))
+    {
+        preserve(plane, tp);
         leftBottom(tp) = upper;
+    }
     rightTop(lower) = upper;
 
     // adjust corner stitches along right edge
     for (tp = topRight(lower); tp && getBottom(tp) >= y; tp = leftBottom(tp))
+    {
+        preserve(plane, tp);
         bottomLeft(tp) = upper;
+    }
     topRight(lower) = tp;
 
     // adjust corner stitches along left edge
@@ -65,6 +74,7 @@ CENTO_FORCEINLINE HorzSplit splitTileHorz(Plane& plane, Tile* tile, const i32 y)
     bottomLeft(upper) = tp;
     while (tp && topRight(tp) == lower)
     {
+        preserve(plane, tp);
         topRight(tp) = upper;
         tp = rightTop(tp);
     }
@@ -89,6 +99,9 @@ CENTO_FORCEINLINE VertSplit splitTileVert(Plane& plane, Tile* tile, const i32 x)
     if (lowerLeft(r).x >= x) { return {}; }
     if (upperRight(r).x <= x) { return {}; }
 
+    record(plane, Change::Split, r);
+    preserve(plane, tile);
+
     Tile* const left  = tile;
     Tile* const right = get(plane);
 
@@ -108,12 +121,18 @@ CENTO_FORCEINLINE VertSplit splitTileVert(Plane& plane, Tile* tile, const i32 x)
 
     // adjust corner stitches along the right edge
     for (tp = topRight(left); tp && bottomLeft(tp) == left; tp = leftBottom(tp))
+    {
+        preserve(plane, tp);
         bottomLeft(tp) = right;
+    }
     topRight(left) = right;
 
     // adjust corner stitches along the top edge
     for (tp = rightTop(left); tp && getLeft(tp) >= x; tp = bottomLeft(tp))
+    {
+        preserve(plane, tp);
         leftBottom(tp) = right;
+    }
     rightTop(left) = tp;
 
     // adjust corner stitches along the bottom edge
@@ -123,6 +142,7 @@ CENTO_FORCEINLINE VertSplit splitTileVert(Plane& plane, Tile* tile, const i32 x)
     leftBottom(right) = tp;
     while (tp && rightTop(tp) == left)
     {
+        preserve(plane, tp);
         rightTop(tp) = right;
         tp = topRight(tp);
     }
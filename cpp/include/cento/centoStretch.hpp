@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoStretch_hpp
+#define centoStretch_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoDirection.hpp"
+#include "centoExplore.hpp"
+#include "centoPlane.hpp"
+
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+    // Move a coordinate past the cut line, the infinities stay where they are.
+    CENTO_FORCEINLINE i32 stretched(const i32 v, const i32 coordinate, const i32 amount)
+    {
+        if ((v <= coordinate) || (v == nInfinity) || (v == pInfinity)) { return v; }
+
+        const i64 moved = i64(v) + amount;
+        Expects((moved > nInfinity) && (moved < pInfinity));
+
+        return i32(moved);
+    }
+
+}
+
+/*
+ * Stretch the plane along the axis at the cut line through coordinate, a
+ * positive amount opens a band of that width just beyond the line and a
+ * negative one closes the band [coordinate, coordinate - amount).  Stretching
+ * along Axis::Horizontal moves x coordinates and so cuts along a vertical line,
+ * Axis::Vertical moves y coordinates.
+ *
+ * Every coordinate beyond the line is moved by the amount, so tiles lying
+ * wholly beyond it move and the tiles covering the strip just beyond it, those
+ * the line passes through, grow or shrink.  Only coordinates are rewritten, the
+ * stitches and so the shape of the space are untouched, and only the tiles
+ * reaching beyond the line are visited.
+ *
+ * Closing a band fails, leaving the plane as it was, unless every tile
+ * overlapping the band spans the whole of it and keeps some width.
+ */
+CENTO_FORCEINLINE bool stretch(Plane& plane, const i32 coordinate, const i32 amount, const Axis axis)
+{
+    Expects((coordinate != nInfinity) && (coordinate != pInfinity));
+
+    if (amount == 0) { return true; }
+
+    const bool horizontal = (axis == Axis::Horizontal);
+    auto       low        = [=](const Tile* t) { return horizontal ? getLeft(t) : getBottom(t); };
+    auto       high       = [=](const Tile* t) { return horizontal ? getRight(t) : getTop(t); };
+
+    const Rect beyond = horizontal ? Rect{{coordinate, nInfinity}, {pInfinity, pInfinity}}
+                                   : Rect{{nInfinity, coordinate}, {pInfinity, pInfinity}};
+
+    const auto lock = lockEdit(plane);
+
+    // the tiles are gathered first as the walk relies on the coordinates
+    std::vector<Tile*> tiles;
+    query(plane, beyond, [&](Tile* t) { tiles.push_back(t); });
+
+    if (amount < 0)
+    {
+        const i64 far = i64(coordinate) - amount;
+        for (const Tile* const t : tiles)
+        {
+            if (high(t) <= coordinate) { continue; }
+            if (low(t) >= far) { continue; }
+
+            // a tile overlapping the band must span it and keep some width
+            const bool spans = (low(t) <= coordinate) && (high(t) >= far);
+            if (not spans || ((low(t) == coordinate) && (high(t) == far))) { return false; }
+        }
+    }
+
+    for (Tile* const t : tiles)
+    {
+        preserve(plane, t);
+
+        Rect r = getRect(t);
+        if (horizontal)
+        {
+            r.ll.x = detail::stretched(r.ll.x, coordinate, amount);
+            r.ur.x = detail::stretched(r.ur.x, coordinate, amount);
+        }
+        else
+        {
+            r.ll.y = detail::stretched(r.ll.y, coordinate, amount);
+            r.ur.y = detail::stretched(r.ur.y, coordinate, amount);
+        }
+        Ensures((r.ll.x < r.ur.x) && (r.ll.y < r.ur.y));
+
+        setRect(t, r);
+    }
+
+    record(plane, Change::Body, beyond);
+    notify(plane);
+
+    return true;
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoStretch_hpp
@@ -0,0 +1,439 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#ifndef centoTransaction_hpp
+#define centoTransaction_hpp
+
+#pragma once
+
+#include "centoNamespace.hpp"
+#include "centoMacros.hpp"
+#include "centoCreate.hpp"
+#include "centoExplore.hpp"
+#include "centoFind.hpp"
+#include "centoInsert.hpp"
+#include "centoPlane.hpp"
+#include "centoRemove.hpp"
+#include "centoShared.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <gsl/assert>
+
+CENTO_BEGIN_NAMESPACE
+
+/*
+ * A plane which several writers may edit at once, as long as the parts of the
+ * plane their edits touch do not overlap.
+ *
+ * Each edit first locks its footprint, the bounding rect of every tile the
+ * edit may read or change.  Splitting and joining tiles reaches up to two
+ * tiles away from the tiles touching the edited area, so the footprint covers
+ * those touching tiles along with two rings of their neighbours.  Edits whose
+ * footprints overlap wait for each other, the rest run side by side.
+ *
+ * Footprints are only small where the plane is dense, a space tile running off
+ * to infinity puts infinity in the footprint of any edit next to it.  Edits in
+ * a sparse plane are therefore mostly serialised, but never wrong.
+ *
+ * Finding a footprint walks the tiles while other edits are running.  The walk
+ * holds a search area of its own which no edit may overlap, and only steps to
+ * tiles known to hold a point of that area, growing the area and walking again
+ * when it has to go further.  Once found the footprint is taken for the edit
+ * if no edit or other search overlaps it, otherwise the edit waits for one to
+ * finish and searches again.  Searches start from tiles left behind by
+ * finished edits, whose rects are kept with them so that a search can tell
+ * they are still where they were, and first hold as much around the area as
+ * the last footprint found reached around its own.
+ *
+ * Every edit runs on a lane, a plane sharing the tiles but with its own hint
+ * and allocator, so that edits never write to the same hint or free list.
+ * Tiles freed by one lane may have come from another, so the lanes live as long
+ * as the plane does.  Lanes carry no watches or snapshots, those are not
+ * supported here.
+ *
+ * Edits hold the mutex shared, reads of the whole plane hold it exclusively.
+ */
+struct TransactionalPlane
+{
+    Plane                               plane;
+    std::deque<Plane>                   lanes;
+    std::vector<Plane*>                 idle;
+    std::vector<Rect>                   regions;  // the footprints of the edits in flight
+    std::vector<Rect>                   searches; // the areas held by footprint searches
+    std::vector<std::pair<Tile*, Rect>> hints;    // tiles left by finished edits
+    i32                                 reach = 0;
+    std::shared_mutex                   mutex;
+    std::mutex                          table;
+    std::condition_variable             released;
+};
+
+namespace detail
+{
+
+    constexpr const usize MaxHints = 32;
+
+    // Grow the rect by one unit so that the tiles touching it are found too,
+    // stopping short of infinity which queries cannot reach past.
+    CENTO_FORCEINLINE Rect touching(const Rect& r) noexcept
+    {
+        auto lo = [](const i32 v) { return (v > nInfinity + 1) ? v - 1 : nInfinity + 1; };
+        auto hi = [](const i32 v) { return (v < pInfinity - 1) ? v + 1 : pInfinity - 1; };
+
+        return {.ll = {lo(r.ll.x), lo(r.ll.y)}, .ur = {hi(r.ur.x), hi(r.ur.y)}};
+    }
+
+    // Grow the rect by the distance on every side, stopping short of infinity.
+    CENTO_FORCEINLINE Rect grown(const Rect& r, const i32 by) noexcept
+    {
+        auto lo = [&](const i32 v) { return i32(std::max(i64(v) - by, i64(nInfinity + 1))); };
+        auto hi = [&](const i32 v) { return i32(std::min(i64(v) + by, i64(pInfinity - 1))); };
+
+        return {.ll = {lo(r.ll.x), lo(r.ll.y)}, .ur = {hi(r.ur.x), hi(r.ur.y)}};
+    }
+
+    // How far the box reaches beyond the area on its nearest side which does
+    // not run off to infinity.
+    CENTO_FORCEINLINE i32 reachOf(const Rect& box, const Rect& area) noexcept
+    {
+        i64 reach = 0;
+        for (const auto& [to, from] : {std::pair{i64(area.ll.x), i64(box.ll.x)}, std::pair{i64(area.ll.y), i64(box.ll.y)},
+                                      std::pair{i64(box.ur.x), i64(area.ur.x)}, std::pair{i64(box.ur.y), i64(area.ur.y)}})
+        {
+            if ((from == nInfinity) || (to == pInfinity)) { continue; }
+            reach = std::max(reach, to - from);
+        }
+
+        return i32(std::min(reach, i64(pInfinity)));
+    }
+
+    // The unit square at the point.
+    CENTO_FORCEINLINE Rect cell(const Point& p) noexcept
+    {
+        return {.ll = p, .ur = {p.x + 1, p.y + 1}};
+    }
+
+    /*
+     * A walk over the tiles which may only read those holding some point of
+     * the held area.  Each stitch points at the tile holding the point just
+     * past the corner the stitch is at, so that point is checked before the
+     * stitch is followed.  A stitch leading out of the held area is treated as
+     * if it led nowhere and the point is added to the missed area instead.
+     */
+    struct Search
+    {
+        Rect held;
+        Rect missed  = {};
+        bool missing = false;
+
+        CENTO_FORCEINLINE Tile* follow(Tile* stitch, const Point& p)
+        {
+            if (stitch == nullptr) { return nullptr; }
+
+            const bool inside = (p.x >= held.ll.x) && (p.x < held.ur.x) &&
+                                (p.y >= held.ll.y) && (p.y < held.ur.y);
+            if (inside) { return stitch; }
+
+            missed  = missing ? boundingBox(missed, cell(p)) : cell(p);
+            missing = true;
+            return nullptr;
+        }
+
+        CENTO_FORCEINLINE Tile* below(Tile* t)
+        {
+            return leftBottom(t) ? follow(leftBottom(t), {getLeft(t), getBottom(t) - 1}) : nullptr;
+        }
+
+        CENTO_FORCEINLINE Tile* left(Tile* t)
+        {
+            return bottomLeft(t) ? follow(bottomLeft(t), {getLeft(t) - 1, getBottom(t)}) : nullptr;
+        }
+
+        CENTO_FORCEINLINE Tile* above(Tile* t)
+        {
+            return rightTop(t) ? follow(rightTop(t), {getRight(t) - 1, getTop(t)}) : nullptr;
+        }
+
+        CENTO_FORCEINLINE Tile* right(Tile* t)
+        {
+            return topRight(t) ? follow(topRight(t), {getRight(t), getTop(t) - 1}) : nullptr;
+        }
+
+        // The point finding walk of findTileAt, nullptr if it left the area.
+        CENTO_FORCEINLINE Tile* locate(Tile* t, const Point& p)
+        {
+            if (p.y < getBottom(t))
+            {
+                do { t = below(t); } while (t && (p.y < getBottom(t)));
+            }
+            else
+            {
+                while (t && (p.y >= getTop(t))) { t = above(t); }
+            }
+
+            if (t == nullptr) { return nullptr; }
+
+            if (p.x < getLeft(t))
+            {
+                do
+                {
+                    do { t = left(t); } while (t && (p.x < getLeft(t)));
+                    if ((t == nullptr) || (p.y < getTop(t))) { break; }
+                    do { t = above(t); } while (t && (p.y >= getTop(t)));
+                } while (t && (p.x < getLeft(t)));
+            }
+            else
+            {
+                while (p.x >= getRight(t))
+                {
+                    do { t = right(t); } while (t && (p.x >= getRight(t)));
+                    if ((t == nullptr) || (p.y >= getBottom(t))) { break; }
+                    do { t = below(t); } while (t && (p.y < getBottom(t)));
+                    if (t == nullptr) { break; }
+                }
+            }
+
+            return t;
+        }
+
+        // The tiles along each side of the tile, as topTiles, leftTiles,
+        // bottomTiles and rightTiles.
+        template <typename F> requires std::invocable<F&, Tile*>
+        CENTO_FORCEINLINE void neighbours(Tile* t, F& callback)
+        {
+            for (Tile* n = above(t); n; n = (getLeft(n) > getLeft(t)) ? left(n) : nullptr) { callback(n); }
+            for (Tile* n = left(t); n; n = (getTop(n) < getTop(t)) ? above(n) : nullptr) { callback(n); }
+            for (Tile* n = below(t); n; n = (getRight(n) < getRight(t)) ? right(n) : nullptr) { callback(n); }
+            for (Tile* n = right(t); n; n = (getBottom(n) > getBottom(t)) ? below(n) : nullptr) { callback(n); }
+        }
+    };
+
+    /*
+     * Search for the footprint of an edit of the area starting from the hint,
+     * start is set to the tile holding the top left corner of the area where
+     * the edit will begin its own search.  Returns false if the search had to
+     * leave the held area, which is then in the missed area of the search.
+     */
+    CENTO_FORCEINLINE bool footprint(Search& search, Tile* hint, const Rect& area, Rect& box, Tile*& start)
+    {
+        search.missing = false;
+
+        const Rect near = touching(area);
+
+        start = search.locate(hint, {area.ll.x, area.ur.y - 1});
+        Tile* const first = start ? search.locate(start, near.ll) : nullptr;
+        if (first == nullptr) { return false; }
+
+        // the tiles touching the area, they cover it so each is found from
+        // another next to it
+        std::vector<Tile*>        ring = {first};
+        std::unordered_set<Tile*> seen = {first};
+
+        auto touch = [&](Tile* t)
+        {
+            if (overlaps(getRect(t), near) && seen.insert(t).second) { ring.push_back(t); }
+        };
+        for (usize i = 0; i < ring.size(); ++i) { search.neighbours(ring[i], touch); }
+
+        box = getRect(start);
+        for (Tile* const t : ring) { box = boundingBox(box, getRect(t)); }
+
+        const usize inner = ring.size();
+
+        auto grow = [&](Tile* t)
+        {
+            box = boundingBox(box, getRect(t));
+            if (seen.insert(t).second) { ring.push_back(t); }
+        };
+        for (usize i = 0; i < inner; ++i) { search.neighbours(ring[i], grow); }
+
+        auto bound = [&](Tile* t) { box = boundingBox(box, getRect(t)); };
+        for (usize i = inner; i < ring.size(); ++i) { search.neighbours(ring[i], bound); }
+
+        return not search.missing;
+    }
+
+    CENTO_FORCEINLINE bool isFree(const std::span<const Rect> held, const Rect& box)
+    {
+        return std::ranges::none_of(held, [&](const Rect& r) { return overlaps(r, box); });
+    }
+
+    /*
+     * The hint nearest to the area which no edit in flight may be changing, or
+     * nullptr if there is none.
+     */
+    CENTO_FORCEINLINE const std::pair<Tile*, Rect>* nearestHint(const TransactionalPlane& tp, const Rect& area)
+    {
+        auto gap = [](const i32 lo, const i32 hi, const i32 v) -> i64
+        {
+            return (v < lo) ? i64(lo) - v : (v >= hi) ? i64(v) - hi + 1 : 0;
+        };
+
+        const std::pair<Tile*, Rect>* best  = nullptr;
+        i64                           bestd = 0;
+        for (const auto& h : tp.hints)
+        {
+            if (not isFree(tp.regions, h.second)) { continue; }
+
+            const i64 d = gap(h.second.ll.x, h.second.ur.x, area.ll.x) + gap(h.second.ll.y, h.second.ur.y, area.ll.y);
+            if ((best == nullptr) || (d < bestd)) { best = &h; bestd = d; }
+        }
+
+        return best;
+    }
+
+    /*
+     * The lock on the footprint of an edit, on release the tile the lane was
+     * left at is kept as a hint for later searches in place of any hints the
+     * edit may have changed.
+     */
+    struct Region
+    {
+        TransactionalPlane& tp;
+        Plane&              lane;
+        Rect                box;
+
+        ~Region()
+        {
+            {
+                std::lock_guard lock(tp.table);
+
+                std::erase_if(tp.hints, [&](const auto& h) { return overlaps(h.second, box); });
+                tp.hints.emplace_back(lane.hint, getRect(lane.hint));
+                if (tp.hints.size() > MaxHints) { tp.hints.erase(tp.hints.begin()); }
+
+                tp.plane.hint = lane.hint;
+                tp.regions.erase(std::ranges::find(tp.regions, box));
+                tp.idle.push_back(&lane);
+            }
+
+            tp.released.notify_all();
+        }
+    };
+
+}
+
+CENTO_FORCEINLINE Tile* createUniverse(TransactionalPlane& tp)
+{
+    Tile* const t = createUniverse(tp.plane);
+    tp.hints.assign(1, {t, getRect(t)});
+
+    return t;
+}
+
+/*
+ * Run the callback as an edit of the area, it is handed a lane of the plane to
+ * make its changes through and must stay within the area.  Waits until no
+ * edit in flight or search overlaps the footprint of the area, searching for
+ * the footprint again each time as the waited on edits change it.
+ */
+template <typename F> requires std::invocable<F&&, Plane&>
+CENTO_FORCEINLINE decltype(auto) transact(TransactionalPlane& tp, const Rect& area, F&& callback)
+{
+    std::shared_lock lock(tp.mutex);
+
+    Plane* lane  = nullptr;
+    Tile*  start = nullptr;
+    Rect   box   = {};
+
+    {
+        std::unique_lock table(tp.table);
+
+        detail::Search search{.held = detail::grown(detail::touching(area), tp.reach)};
+        for (;;)
+        {
+            // 1. Hold the area to search along with a cell of the hint to start
+            //    from, once no edit in flight overlaps them.
+            Tile* hint = nullptr;
+            tp.released.wait(table, [&]()
+            {
+                const std::pair<Tile*, Rect>* h = detail::nearestHint(tp, area);
+                if (h == nullptr) { return false; }
+
+                const Point p{std::clamp(area.ll.x, h->second.ll.x, h->second.ur.x - 1),
+                              std::clamp(area.ll.y, h->second.ll.y, h->second.ur.y - 1)};
+                const Rect  held = boundingBox(search.held, detail::cell(p));
+                if (not detail::isFree(tp.regions, held)) { return false; }
+
+                search.held = held;
+                hint        = h->first;
+                return true;
+            });
+            tp.searches.push_back(search.held);
+            table.unlock();
+
+            // 2. Search without holding the table.
+            const bool found = detail::footprint(search, hint, area, box, start);
+
+            table.lock();
+            tp.searches.erase(std::ranges::find(tp.searches, search.held));
+            tp.released.notify_all();
+
+            if (not found)
+            {
+                Expects(search.missing);
+                search.held = boundingBox(search.held, search.missed);
+                continue;
+            }
+
+            // 3. Take the footprint if nothing else holds any of it, or wait
+            //    for a change and search again.
+            if (detail::isFree(tp.regions, box) && detail::isFree(tp.searches, box)) { break; }
+            tp.released.wait(table);
+        }
+
+        tp.reach = detail::reachOf(box, area);
+        tp.regions.push_back(box);
+        if (tp.idle.empty()) { tp.idle.push_back(&tp.lanes.emplace_back()); }
+        lane = tp.idle.back();
+        tp.idle.pop_back();
+    }
+
+    const detail::Region region{tp, *lane, box};
+
+    lane->hint = start;
+    return std::invoke(std::forward<F>(callback), *lane);
+}
+
+CENTO_FORCEINLINE Tile* insertTile(TransactionalPlane& tp, const TilePlan& plan)
+{
+    return transact(tp, plan.rect, [&](Plane& lane) { return insertTile(lane, plan); });
+}
+
+CENTO_FORCEINLINE void removeTile(TransactionalPlane& tp, Tile* tile)
+{
+    Expects(not isSpace(tile));
+
+    // the rect of a solid tile never changes so it is safe to read unlocked
+    transact(tp, getRect(tile), [&](Plane& lane) { removeTile(lane, tile); });
+}
+
+/*
+ * Read the plane once every edit in flight has finished, holding off any more
+ * edits until the callback returns.
+ */
+template <typename F> requires std::invocable<F&&, PlaneReader&>
+CENTO_FORCEINLINE decltype(auto) read(TransactionalPlane& tp, F&& callback)
+{
+    std::unique_lock lock(tp.mutex);
+    PlaneReader      reader(tp.plane);
+
+    return std::invoke(std::forward<F>(callback), reader);
+}
+
+CENTO_END_NAMESPACE
+
+#endif // centoTransaction_hpp
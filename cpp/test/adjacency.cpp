@@ -0,0 +1,99 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoAdjacency.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <map>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    // the neighbours of a tile by id along with the shared edge length
+    std::map<u64, i64> neighboursOf(const cento::Adjacency& graph, const cento::Tile* t)
+    {
+        const auto it = std::ranges::find(graph.tiles, t);
+        const u32  i  = u32(it - graph.tiles.begin());
+
+        std::map<u64, i64> ret;
+        const std::span<const u32> n = cento::adjacent(graph, i);
+        const std::span<const i64> l = cento::sharedLengths(graph, i);
+        for (usize j = 0; j < n.size(); ++j)
+        {
+            ret[graph.tiles[n[j]]->id] = l[j];
+        }
+
+        return ret;
+    }
+
+}
+
+suite adjacency = []()
+{
+    "universe"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        const cento::Adjacency graph = cento::buildAdjacency(plane, {{-10, -10}, {10, 10}});
+        expect(graph.tiles.empty());
+        expect(graph.offsets.size() == 1);
+    };
+
+    "touching"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        /*
+         *  +---+---+
+         *  | 2 | 3 |   +---+
+         *  +---+---+   | 4 |
+         *  |   1   |   +---+
+         *  +-------+
+         */
+
+        cento::Tile* const t1 = cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {20, 10}}});
+        cento::Tile* const t2 = cento::insertTile(plane, {.id = 2, .rect = {{0, 10}, {10, 20}}});
+        cento::Tile* const t3 = cento::insertTile(plane, {.id = 3, .rect = {{10, 10}, {20, 25}}});
+        cento::Tile* const t4 = cento::insertTile(plane, {.id = 4, .rect = {{30, 5}, {40, 15}}});
+
+        const cento::Adjacency graph = cento::buildAdjacency(plane, {{-10, -10}, {50, 50}});
+
+        expect(graph.tiles.size() == 4);
+        expect(graph.neighbours.size() == 6);
+
+        expect(neighboursOf(graph, t1) == std::map<u64, i64>{{2, 10}, {3, 10}});
+        expect(neighboursOf(graph, t2) == std::map<u64, i64>{{1, 10}, {3, 10}});
+        expect(neighboursOf(graph, t3) == std::map<u64, i64>{{1, 10}, {2, 10}});
+        expect(neighboursOf(graph, t4).empty());
+    };
+
+    "clipped"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::Tile* const t1 = cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{10, 0}, {20, 10}}});
+
+        // the second tile is outside of the area so it is not in the graph
+        const cento::Adjacency graph = cento::buildAdjacency(plane, {{-10, -10}, {10, 20}});
+
+        expect(graph.tiles == std::vector<cento::Tile*>{t1});
+        expect(graph.neighbours.empty());
+    };
+};
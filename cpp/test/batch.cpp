@@ -0,0 +1,174 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoBatch.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace boost::ut;
+
+suite batch = []()
+{
+    "matches_query"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // a 16 x 16 grid of 16 x 16 tiles on a 32 unit pitch
+        u64 id = 0;
+        for (i32 y = 0; y < 16; ++y)
+        {
+            for (i32 x = 0; x < 16; ++x)
+            {
+                const cento::Rect r{.ll = {.x = x * 32, .y = y * 32},
+                                    .ur = {.x = x * 32 + 16, .y = y * 32 + 16}};
+                cento::insertTile(plane, {.id = id++, .rect = r});
+            }
+        }
+
+        std::vector<cento::Rect> areas;
+        for (i32 y = -32; y < 512; y += 24)
+        {
+            for (i32 x = -32; x < 512; x += 40)
+            {
+                areas.push_back({.ll = {.x = x, .y = y},
+                                 .ur = {.x = x + 100, .y = y + 60}});
+            }
+        }
+
+        std::vector<std::vector<u64>> expected(areas.size());
+        for (usize i = 0; i < areas.size(); ++i)
+        {
+            cento::query(plane, areas[i], [&](cento::Tile* t)
+            {
+                expected[i].push_back(t->id);
+            });
+            std::ranges::sort(expected[i]);
+        }
+
+        const cento::Tile* const hint = plane.hint;
+
+        std::mutex                    mutex;
+        std::vector<std::vector<u64>> found(areas.size());
+        cento::queryBatch(plane, areas, [&](usize i, cento::Tile* t)
+        {
+            std::lock_guard lock{mutex};
+            found[i].push_back(t->id);
+        });
+        for (std::vector<u64>& f : found) { std::ranges::sort(f); }
+
+        expect(found == expected);
+        expect(plane.hint == hint);
+    };
+
+    "solid_only"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 0, .rect = {{0, 0}, {16, 16}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{32, 0}, {48, 16}}});
+
+        const std::vector<cento::Rect> areas =
+        {
+            {{-8, -8}, {24, 24}},
+            {{-8, -8}, {56, 24}},
+            {{100, 100}, {200, 200}},
+        };
+
+        std::atomic<i32> counts[3] = {0, 0, 0};
+        cento::querySolidBatch(plane, areas, [&](usize i, cento::Tile*)
+        {
+            ++counts[i];
+        });
+
+        expect(counts[0] == 1_i);
+        expect(counts[1] == 2_i);
+        expect(counts[2] == 0_i);
+    };
+
+    "for_each_tile"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // rows of tiles of mixed heights, so plenty of tiles cross the cuts
+        // between the bands
+        u64 id = 0;
+        for (i32 y = 0; y < 24; ++y)
+        {
+            for (i32 x = 0; x < 24; ++x)
+            {
+                const i32 h = 4 + ((x * 7 + y * 3) % 5) * 6;
+                cento::insertTile(plane, {.id = id++, .rect = {{x * 20, y * 40}, {x * 20 + 10, y * 40 + h}}});
+            }
+        }
+
+        std::vector<const cento::Tile*> expected;
+        cento::queryAll(plane, [&](cento::Tile* t) { expected.push_back(t); });
+        std::ranges::sort(expected);
+
+        const cento::Tile* const hint = plane.hint;
+
+        for (const usize workers : {1, 2, 4, 16})
+        {
+            std::mutex                      mutex;
+            std::vector<const cento::Tile*> found;
+            cento::parallelForEachTile(plane, [&](cento::Tile* t)
+            {
+                std::lock_guard lock{mutex};
+                found.push_back(t);
+            }, workers);
+            std::ranges::sort(found);
+
+            expect(found == expected);
+        }
+
+        expect(plane.hint == hint);
+    };
+
+    "for_each_tile_empty"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        std::atomic<i32> count = 0;
+        cento::parallelForEachTile(plane, [&](cento::Tile* t)
+        {
+            expect(isSpace(t));
+            ++count;
+        }, 4);
+
+        expect(count == 1_i);
+    };
+
+    "stealing"_test = []()
+    {
+        // all of the slow items start out with the first worker, the rest
+        // must take them off it
+        std::vector<std::atomic<i32>> runs(1000);
+        cento::detail::parallelSteal(runs.size(), 4, [&](usize, usize i)
+        {
+            if (i < 100) { std::this_thread::sleep_for(std::chrono::microseconds(50)); }
+            ++runs[i];
+        });
+
+        expect(std::ranges::all_of(runs, [](const std::atomic<i32>& r) { return r == 1; }));
+    };
+};
@@ -0,0 +1,103 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoBuild.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    StitchLayout sequential(const std::vector<cento::TilePlan>& plans)
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        for (const cento::TilePlan& plan : plans) { cento::insertTile(plane, plan); }
+
+        return stitchLayoutOf(plane);
+    }
+
+    // a random set of tiles with no overlaps, some of them tall enough to
+    // cross several bands
+    std::vector<cento::TilePlan> randomPlans(const usize count)
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        std::vector<cento::TilePlan> plans;
+
+        u32 seed = 11;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for (u64 id = 0; plans.size() < count; ++id)
+        {
+            const i32 x = i32(next() % 1000);
+            const i32 y = i32(next() % 1000);
+            const i32 w = i32(next() % 40) + 1;
+            const i32 h = (next() % 8 == 0) ? i32(next() % 400) + 1 : i32(next() % 20) + 1;
+            const cento::TilePlan plan{.id = id % 7, .rect = {{x, y}, {x + w, y + h}}};
+            if (cento::insertTile(plane, plan)) { plans.push_back(plan); }
+        }
+
+        return plans;
+    }
+
+}
+
+suite build = []()
+{
+    "empty"_test = []()
+    {
+        cento::Plane plane;
+        cento::buildPlane(plane, {});
+
+        expect(stitchLayoutOf(plane) == sequential({}));
+    };
+
+    "stacked"_test = []()
+    {
+        // the same body and width either side of every cut
+        const std::vector<cento::TilePlan> plans{
+            {.id = 1, .rect = {{0, 0}, {10, 10}}},
+            {.id = 1, .rect = {{0, 10}, {10, 20}}},
+            {.id = 1, .rect = {{0, 20}, {10, 30}}},
+            {.id = 2, .rect = {{20, 5}, {30, 25}}},
+        };
+
+        for (usize bands = 1; bands < 6; ++bands)
+        {
+            cento::Plane plane;
+            cento::buildPlane(plane, plans, bands);
+
+            expect(stitchLayoutOf(plane) == sequential(plans));
+        }
+    };
+
+    "matches_sequential"_test = []()
+    {
+        const std::vector<cento::TilePlan> plans = randomPlans(800);
+        const StitchLayout                       want  = sequential(plans);
+
+        for (const usize bands : {1, 2, 3, 7, 16, 64})
+        {
+            cento::Plane plane;
+            cento::buildPlane(plane, plans, bands);
+
+            expect(stitchLayoutOf(plane) == want);
+        }
+    };
+};
@@ -0,0 +1,186 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCell.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace boost::ut;
+
+suite cell = []()
+{
+    "query"_test = []()
+    {
+        // two pads placed four times on a 100 unit pitch
+        cento::Cell pads;
+        cento::createUniverse(pads);
+        cento::insertTile(pads, {.id = 1, .rect = {{0, 0}, {20, 20}}});
+        cento::insertTile(pads, {.id = 2, .rect = {{40, 0}, {60, 20}}});
+
+        cento::Cell top;
+        cento::createUniverse(top);
+        for (const cento::Point origin : {cento::Point{0, 0}, {100, 0}, {0, 100}, {100, 100}})
+        {
+            cento::place(top, pads, origin);
+        }
+
+        expect(top.bounds == cento::Rect{{0, 0}, {160, 120}});
+
+        std::vector<cento::Rect> found;
+        cento::queryCell(top, {{30, -10}, {150, 50}}, [&](cento::Tile* t, const cento::Point& offset)
+        {
+            found.push_back(translate(getRect(t), offset));
+        });
+        std::ranges::sort(found);
+
+        const std::vector<cento::Rect> expected = {{{40, 0}, {60, 20}}, {{100, 0}, {120, 20}}, {{140, 0}, {160, 20}}};
+        expect(found == expected);
+
+        // the geometry of the pads is only stored once
+        usize stored = 0;
+        cento::queryAll(pads.plane, [&](cento::Tile* t) { stored += isSolid(t) ? 1 : 0; });
+        expect(stored == 2);
+        expect(countSolid(top.plane, {{-1000, -1000}, {1000, 1000}}) == 0);
+    };
+
+    "nested"_test = []()
+    {
+        cento::Cell pad;
+        cento::createUniverse(pad);
+        cento::insertTile(pad, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+
+        cento::Cell pair;
+        cento::createUniverse(pair);
+        cento::place(pair, pad, {0, 0});
+        cento::place(pair, pad, {20, 0});
+
+        cento::Cell top;
+        cento::createUniverse(top);
+        cento::insertTile(top, {.id = 2, .rect = {{-50, -50}, {-40, -40}}});
+        cento::place(top, pair, {0, 0});
+        cento::place(top, pair, {0, 30});
+
+        std::vector<cento::TilePlan> flat = cento::flatten(top);
+        std::ranges::sort(flat);
+
+        const std::vector<cento::TilePlan> expected =
+        {
+            {.id = 1, .rect = {{0, 0}, {10, 10}}},
+            {.id = 1, .rect = {{0, 30}, {10, 40}}},
+            {.id = 1, .rect = {{20, 0}, {30, 10}}},
+            {.id = 1, .rect = {{20, 30}, {30, 40}}},
+            {.id = 2, .rect = {{-50, -50}, {-40, -40}}},
+        };
+        expect(flat == expected);
+
+        // an area between the placements reaches none of them
+        usize count = 0;
+        cento::queryCell(top, {{11, 11}, {19, 29}}, [&](cento::Tile*, const cento::Point&) { ++count; });
+        expect(count == 0);
+    };
+
+    "array"_test = []()
+    {
+        cento::Cell pad;
+        cento::createUniverse(pad);
+        cento::insertTile(pad, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+
+        // a million copies on a 20 unit pitch, stored as one placement
+        cento::Cell top;
+        cento::createUniverse(top);
+        cento::place(top, pad, {-5000, 100}, 1000, 1000, {20, 20});
+
+        expect(top.placements.size() == 1);
+        expect(top.bounds == cento::Rect{{-5000, 100}, {14990, 20090}});
+
+        // check the copies found against the copies worked out one by one
+        const std::vector<cento::Rect> areas =
+        {
+            {{-5000, 100}, {-4990, 110}},
+            {{-4990, 110}, {-4980, 120}},
+            {{-4995, 105}, {-4915, 145}},
+            {{-9000, -9000}, {-4999, 101}},
+            {{14980, 20080}, {30000, 30000}},
+            {{0, 0}, {5, 5000}},
+            {{37, 1033}, {151, 1077}},
+        };
+        for (const cento::Rect& area : areas)
+        {
+            std::vector<cento::Rect> found;
+            cento::queryCell(top, area, [&](cento::Tile* t, const cento::Point& offset)
+            {
+                found.push_back(translate(getRect(t), offset));
+            });
+            std::ranges::sort(found);
+
+            std::vector<cento::Rect> expected;
+            const i32 c0 = std::max(0, (area.ll.x + 5000 - 10) / 20 - 1);
+            const i32 r0 = std::max(0, (area.ll.y - 100 - 10) / 20 - 1);
+            for (i32 r = r0; r < std::min(1000, r0 + 300); ++r)
+            {
+                for (i32 c = c0; c < std::min(1000, c0 + 300); ++c)
+                {
+                    const cento::Rect copy{{-5000 + c * 20, 100 + r * 20}, {-4990 + c * 20, 110 + r * 20}};
+                    if (overlaps(copy, area)) { expected.push_back(copy); }
+                }
+            }
+            std::ranges::sort(expected);
+
+            expect(found == expected);
+        }
+    };
+
+    "parallel_flatten"_test = []()
+    {
+        cento::Cell pad;
+        cento::createUniverse(pad);
+        cento::insertTile(pad, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(pad, {.id = 2, .rect = {{12, 0}, {14, 4}}});
+
+        cento::Cell row;
+        cento::createUniverse(row);
+        cento::insertTile(row, {.id = 3, .rect = {{0, 20}, {100, 25}}});
+        cento::place(row, pad, {0, 0}, 5, 1, {20, 0});
+
+        cento::Cell top;
+        cento::createUniverse(top);
+        cento::place(top, row, {0, 0}, 30, 40, {200, 50});
+        cento::place(top, pad, {-100, -100});
+        cento::place(top, row, {7, -300});
+
+        std::vector<cento::TilePlan> serial = cento::flatten(top);
+        std::ranges::sort(serial);
+
+        for (const usize workers : {1, 4})
+        {
+            std::vector<cento::TilePlan> parallel = cento::parallelFlatten(top, workers);
+            std::ranges::sort(parallel);
+
+            expect(parallel.size() == 1200 * 11 + 2 + 11);
+            expect(parallel == serial);
+        }
+    };
+
+    "empty"_test = []()
+    {
+        cento::Cell none;
+        cento::createUniverse(none);
+
+        cento::Cell top;
+        cento::createUniverse(top);
+        cento::place(top, none, {10, 10});
+
+        expect(cento::isEmpty(top));
+        expect(cento::flatten(top).empty());
+    };
+};
@@ -0,0 +1,160 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoChannel.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    std::vector<cento::Rect> sorted(std::vector<cento::Rect> rects)
+    {
+        std::ranges::sort(rects);
+        return rects;
+    }
+
+    // Every maximal empty rect of a small grid found by trying them all.
+    template <usize N>
+    std::vector<cento::Rect> bruteForce(const std::array<std::array<bool, N>, N>& full, const i32 minW, const i32 minH)
+    {
+        auto empty = [&](const i32 l, const i32 b, const i32 r, const i32 t)
+        {
+            if ((l < 0) || (b < 0) || (r > i32(N)) || (t > i32(N))) { return false; }
+            for (i32 y = b; y < t; ++y)
+            {
+                for (i32 x = l; x < r; ++x)
+                {
+                    if (full[y][x]) { return false; }
+                }
+            }
+            return true;
+        };
+
+        std::vector<cento::Rect> found;
+        for (i32 b = 0; b < i32(N); ++b)
+        {
+            for (i32 t = b + minH; t <= i32(N); ++t)
+            {
+                for (i32 l = 0; l < i32(N); ++l)
+                {
+                    for (i32 r = l + minW; r <= i32(N); ++r)
+                    {
+                        if (not empty(l, b, r, t)) { break; }
+                        if (empty(l - 1, b, r, t) || empty(l, b - 1, r, t) ||
+                            empty(l, b, r + 1, t) || empty(l, b, r, t + 1)) { continue; }
+
+                        found.push_back({{l, b}, {r, t}});
+                    }
+                }
+            }
+        }
+        std::ranges::sort(found);
+
+        return found;
+    }
+
+}
+
+suite channel = []()
+{
+    "maximal"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{20, 10}, {30, 20}}});
+
+        // the region around the two tiles leaves two l shapes of space
+        const std::vector<cento::Rect> expected =
+        {
+            {{0, 10}, {20, 30}},
+            {{0, 20}, {30, 30}},
+            {{10, 0}, {20, 30}},
+            {{10, 0}, {30, 10}},
+        };
+        expect(sorted(cento::maximalEmptyRects(plane, {{0, 0}, {30, 30}}, 1, 1)) == expected);
+
+        // only the wide rects are at least 15 across
+        const std::vector<cento::Rect> wide =
+        {
+            {{0, 10}, {20, 30}},
+            {{0, 20}, {30, 30}},
+            {{10, 0}, {30, 10}},
+        };
+        expect(sorted(cento::maximalEmptyRects(plane, {{0, 0}, {30, 30}}, 15, 1)) == wide);
+    };
+
+    "random"_test = []()
+    {
+        constexpr usize N = 24;
+
+        std::mt19937                       rng(7);
+        std::uniform_int_distribution<i32> pos(-2, i32(N));
+        std::uniform_int_distribution<i32> size(1, 6);
+
+        for (usize round = 0; round < 20; ++round)
+        {
+            cento::Plane plane;
+            cento::createUniverse(plane);
+
+            std::array<std::array<bool, N>, N> full{};
+            for (u64 id = 1; id <= 30; ++id)
+            {
+                const cento::Point ll{pos(rng), pos(rng)};
+                const cento::Rect  r{ll, {ll.x + size(rng), ll.y + size(rng)}};
+                if (cento::insertTile(plane, {.id = id, .rect = r}) == nullptr) { continue; }
+
+                for (i32 y = std::max(r.ll.y, 0); y < std::min(r.ur.y, i32(N)); ++y)
+                {
+                    for (i32 x = std::max(r.ll.x, 0); x < std::min(r.ur.x, i32(N)); ++x) { full[y][x] = true; }
+                }
+            }
+
+            const cento::Rect region{{0, 0}, {i32(N), i32(N)}};
+            expect(sorted(cento::maximalEmptyRects(plane, region, 1, 1)) == bruteForce(full, 1, 1));
+            expect(sorted(cento::maximalEmptyRects(plane, region, 3, 2)) == bruteForce(full, 3, 2));
+        }
+    };
+
+    "channels"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{20, 0}, {30, 10}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{0, 20}, {30, 30}}});
+
+        // the strips below and above the first two tiles, and the gap between
+        // them which runs on into both
+        const std::vector<cento::Rect> expected =
+        {
+            {{0, -5}, {30, 0}},
+            {{0, 10}, {30, 20}},
+            {{10, -5}, {20, 20}},
+        };
+        expect(sorted(cento::findChannels(plane, {{0, -5}, {30, 30}}, 1)) == expected);
+
+        // the strips across are too thin for a channel of 12
+        const std::vector<cento::Rect> tall = {{{10, -5}, {20, 20}}};
+        expect(cento::findChannels(plane, {{0, -5}, {30, 30}}, 12) == tall);
+    };
+};
@@ -0,0 +1,202 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCompact.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoExplore.hpp"
+#include "cento/centoInsert.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    std::vector<cento::TilePlan> solids(const cento::Plane& plane)
+    {
+        std::vector<cento::TilePlan> all;
+        cento::queryAll(plane, [&](cento::Tile* t)
+        {
+            if (isSolid(t)) { all.push_back({.id = t->id, .rect = getRect(t)}); }
+        });
+        std::ranges::sort(all);
+
+        return all;
+    }
+
+}
+
+suite compact = []()
+{
+    "horizontal"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{50, 0}, {60, 10}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{100, 5}, {110, 20}}});
+        cento::insertTile(plane, {.id = 4, .rect = {{30, 30}, {40, 40}}});
+
+        const usize moved = cento::compact(plane, cento::Axis::Horizontal, [](u64, u64) { return 5; });
+        expect(moved == 3);
+
+        // the third tile is held back by the second, the fourth by nothing
+        const std::vector<cento::TilePlan> expected =
+        {
+            {.id = 1, .rect = {{0, 0}, {10, 10}}},
+            {.id = 2, .rect = {{15, 0}, {25, 10}}},
+            {.id = 3, .rect = {{30, 5}, {40, 20}}},
+            {.id = 4, .rect = {{0, 30}, {10, 40}}},
+        };
+        expect(solids(plane) == expected);
+
+        // a compacted layout stays as it is
+        expect(cento::compact(plane, cento::Axis::Horizontal, [](u64, u64) { return 5; }) == 0);
+    };
+
+    "vertical"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{0, 50}, {10, 60}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{5, 100}, {20, 110}}});
+
+        // tiles of the same id may sit closer together
+        auto spacing = [](const u64 a, const u64 b) { return (a + b == 5) ? 2 : 6; };
+        cento::compact(plane, cento::Axis::Vertical, spacing);
+
+        const std::vector<cento::TilePlan> expected =
+        {
+            {.id = 1, .rect = {{0, 0}, {10, 10}}},
+            {.id = 2, .rect = {{0, 16}, {10, 26}}},
+            {.id = 3, .rect = {{5, 28}, {20, 38}}},
+        };
+        expect(solids(plane) == expected);
+    };
+
+    "abutting"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // two tiles of one id side by side are one shape and stay together
+        cento::insertTile(plane, {.id = 2, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{30, 0}, {40, 10}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{40, 0}, {50, 10}}});
+
+        expect(cento::compact(plane, cento::Axis::Horizontal, [](u64, u64) { return 5; }) == 2);
+
+        const std::vector<cento::TilePlan> expected =
+        {
+            {.id = 1, .rect = {{15, 0}, {25, 10}}},
+            {.id = 1, .rect = {{25, 0}, {35, 10}}},
+            {.id = 2, .rect = {{0, 0}, {10, 10}}},
+        };
+        expect(solids(plane) == expected);
+    };
+
+    "shape"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // an l shape cut into a post and a foot, held back as a whole by the
+        // tile before the post, and a tile facing the post from the other side
+        cento::insertTile(plane, {.id = 1, .rect = {{20, 0}, {30, 30}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{30, 0}, {50, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{70, 20}, {80, 30}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{0, 5}, {5, 10}}});
+
+        cento::compact(plane, cento::Axis::Horizontal, [](u64, u64) { return 5; });
+
+        const std::vector<cento::TilePlan> expected =
+        {
+            {.id = 1, .rect = {{10, 0}, {20, 30}}},
+            {.id = 1, .rect = {{20, 0}, {40, 10}}},
+            {.id = 2, .rect = {{25, 20}, {35, 30}}},
+            {.id = 3, .rect = {{0, 5}, {5, 10}}},
+        };
+        expect(solids(plane) == expected);
+
+        // a u shape reaching around a tile, the constraints between the two
+        // make a cycle and the tile is pressed against the left arm
+        cento::Plane u;
+        cento::createUniverse(u);
+        cento::insertTile(u, {.id = 1, .rect = {{10, 0}, {20, 30}}});
+        cento::insertTile(u, {.id = 1, .rect = {{20, 0}, {60, 10}}});
+        cento::insertTile(u, {.id = 1, .rect = {{60, 0}, {70, 30}}});
+        cento::insertTile(u, {.id = 2, .rect = {{40, 20}, {45, 30}}});
+        cento::insertTile(u, {.id = 3, .rect = {{0, 20}, {5, 30}}});
+
+        cento::compact(u, cento::Axis::Horizontal, [](u64, u64) { return 5; });
+
+        const std::vector<cento::TilePlan> inside =
+        {
+            {.id = 1, .rect = {{10, 0}, {20, 30}}},
+            {.id = 1, .rect = {{20, 0}, {60, 10}}},
+            {.id = 1, .rect = {{60, 0}, {70, 30}}},
+            {.id = 2, .rect = {{25, 20}, {30, 30}}},
+            {.id = 3, .rect = {{0, 20}, {5, 30}}},
+        };
+        expect(solids(u) == inside);
+    };
+
+    "random"_test = []()
+    {
+        std::mt19937                       rng(11);
+        std::uniform_int_distribution<i32> pos(0, 2000);
+        std::uniform_int_distribution<i32> size(1, 60);
+
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        for (u64 id = 0; id < 400; ++id)
+        {
+            const cento::Point ll{pos(rng), pos(rng)};
+            cento::insertTile(plane, {.id = id, .rect = {ll, {ll.x + size(rng), ll.y + size(rng)}}});
+        }
+        const usize before = solids(plane).size();
+
+        cento::compact(plane, cento::Axis::Horizontal, [](u64, u64) { return 3; });
+
+        const std::vector<cento::TilePlan> after = solids(plane);
+        expect(after.size() == before);
+
+        // every pair sharing rows keeps its spacing, and each tile is either
+        // at the start or pressed against one before it
+        i32 start = cento::pInfinity;
+        for (const cento::TilePlan& p : after) { start = std::min(start, p.rect.ll.x); }
+
+        bool spaced = true;
+        bool tight  = true;
+        for (const cento::TilePlan& b : after)
+        {
+            bool pressed = (b.rect.ll.x == start);
+            for (const cento::TilePlan& a : after)
+            {
+                const bool rows = (a.rect.ll.y < b.rect.ur.y) && (b.rect.ll.y < a.rect.ur.y);
+                if (not rows || (a.rect.ll.x >= b.rect.ll.x)) { continue; }
+
+                spaced  = spaced && (b.rect.ll.x >= a.rect.ur.x + 3);
+                pressed = pressed || (b.rect.ll.x == a.rect.ur.x + 3);
+            }
+            tight = tight && pressed;
+        }
+        expect(spaced);
+        expect(tight);
+    };
+};
@@ -0,0 +1,120 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoDensity.hpp"
+#include "cento/centoInsert.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    i64 bruteArea(cento::Plane& plane, const cento::Rect& window)
+    {
+        i64 area = 0;
+        cento::querySolid(plane, window, [&](const cento::Tile* t)
+        {
+            const i64 w = i64(std::min(getRight(t), window.ur.x)) - std::max(getLeft(t), window.ll.x);
+            const i64 h = i64(std::min(getTop(t), window.ur.y)) - std::max(getBottom(t), window.ll.y);
+            if ((w > 0) && (h > 0)) { area += w * h; }
+        });
+
+        return area;
+    }
+
+}
+
+suite density = []()
+{
+    "empty"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        const cento::DensityMap map = cento::densityMap(plane, {{0, 0}, {100, 100}}, 10, 10);
+
+        expect(map.columns == 10_i);
+        expect(map.rows == 10_i);
+        expect(std::ranges::all_of(map.area, [](i64 a) { return a == 0; }));
+    };
+
+    "too_small"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        const cento::DensityMap map = cento::densityMap(plane, {{0, 0}, {100, 5}}, 10, 10);
+
+        expect(map.rows == 0_i);
+        expect(map.area.empty());
+    };
+
+    "single"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        cento::insertTile(plane, {.id = 0, .rect = {{0, 0}, {10, 10}}});
+
+        const cento::DensityMap map = cento::densityMap(plane, {{0, 0}, {20, 20}}, 10, 10);
+
+        expect(map.columns == 2_i);
+        expect(map.rows == 2_i);
+        expect(cento::coverage(map, 0, 0) == 100);
+        expect(cento::coverage(map, 1, 0) == 0);
+        expect(cento::coverage(map, 0, 1) == 0);
+        expect(cento::density(map, 0, 0) == 1.0);
+    };
+
+    "sliding"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        u64 id = 0;
+        for (i32 y = 0; y < 8; ++y)
+        {
+            for (i32 x = 0; x < 8; ++x)
+            {
+                const i32 w = 5 + ((x * 7 + y * 3) % 11);
+                const i32 h = 5 + ((x * 5 + y * 11) % 13);
+                const cento::Rect r{.ll = {.x = x * 25, .y = y * 25},
+                                    .ur = {.x = x * 25 + w, .y = y * 25 + h}};
+                cento::insertTile(plane, {.id = id++, .rect = r});
+            }
+        }
+
+        const cento::Rect extent{{-7, -3}, {211, 197}};
+        const i32         window = 37;
+        const i32         step   = 13;
+
+        const cento::DensityMap map = cento::densityMap(plane, extent, window, step);
+
+        expect(map.columns == 14_i);
+        expect(map.rows == 13_i);
+
+        i32 mismatches = 0;
+        for (i32 row = 0; row < map.rows; ++row)
+        {
+            for (i32 column = 0; column < map.columns; ++column)
+            {
+                const cento::Point ll{.x = extent.ll.x + column * step,
+                                      .y = extent.ll.y + row * step};
+                const cento::Rect  w{.ll = ll, .ur = {.x = ll.x + window, .y = ll.y + window}};
+                if (cento::coverage(map, column, row) != bruteArea(plane, w)) { ++mismatches; }
+            }
+        }
+        expect(mismatches == 0_i);
+    };
+};
@@ -0,0 +1,186 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoEdge.hpp"
+#include "cento/centoInsert.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    auto key(const cento::Edge& e)
+    {
+        return std::tuple(e.axis, e.from, e.to, e.low, e.high);
+    }
+
+    /*
+     * Find the edges by checking every unit of every grid line in the area and
+     * joining the neighbouring units which separate the same bodies.
+     */
+    std::vector<cento::Edge> bruteEdges(cento::Plane& plane, const cento::Rect& area)
+    {
+        auto at = [&](i32 x, i32 y) { return cento::findTileAt(plane, {x, y})->id; };
+
+        std::vector<cento::Edge> edges;
+        for (i32 x = area.ll.x + 1; x < area.ur.x; ++x)
+        {
+            for (i32 y = area.ll.y; y < area.ur.y; ++y)
+            {
+                const u64 l = at(x - 1, y);
+                const u64 r = at(x, y);
+                if (l == r) { continue; }
+
+                cento::Edge* back = edges.empty() ? nullptr : &edges.back();
+                if (back && (back->axis == cento::Axis::Vertical) &&
+                    (back->to == cento::Point{x, y}) && (back->low == l) && (back->high == r))
+                {
+                    back->to.y = y + 1;
+                    continue;
+                }
+                edges.push_back({{x, y}, {x, y + 1}, cento::Axis::Vertical, l, r});
+            }
+        }
+        for (i32 y = area.ll.y + 1; y < area.ur.y; ++y)
+        {
+            for (i32 x = area.ll.x; x < area.ur.x; ++x)
+            {
+                const u64 b = at(x, y - 1);
+                const u64 a = at(x, y);
+                if (b == a) { continue; }
+
+                cento::Edge* back = edges.empty() ? nullptr : &edges.back();
+                if (back && (back->axis == cento::Axis::Horizontal) &&
+                    (back->to == cento::Point{x, y}) && (back->low == b) && (back->high == a))
+                {
+                    back->to.x = x + 1;
+                    continue;
+                }
+                edges.push_back({{x, y}, {x + 1, y}, cento::Axis::Horizontal, b, a});
+            }
+        }
+
+        std::ranges::sort(edges, {}, key);
+        return edges;
+    }
+
+}
+
+suite edges = []()
+{
+    "universe"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        i32 count = 0;
+        cento::enumerateEdges(plane, {{-10, -10}, {10, 10}}, [&](const cento::Edge&) { ++count; });
+        expect(count == 0_i);
+    };
+
+    "single"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        cento::insertTile(plane, {.id = 7, .rect = {{0, 0}, {10, 10}}});
+
+        std::vector<cento::Edge> found;
+        cento::enumerateEdges(plane, {{-10, -10}, {20, 20}}, [&](const cento::Edge& e)
+        {
+            found.push_back(e);
+        });
+        std::ranges::sort(found, {}, key);
+
+        const u64 s = cento::Space;
+        std::vector<cento::Edge> expected =
+        {
+            {{0, 0}, {0, 10}, cento::Axis::Vertical, s, 7},
+            {{10, 0}, {10, 10}, cento::Axis::Vertical, 7, s},
+            {{0, 0}, {10, 0}, cento::Axis::Horizontal, s, 7},
+            {{0, 10}, {10, 10}, cento::Axis::Horizontal, 7, s},
+        };
+        std::ranges::sort(expected, {}, key);
+
+        expect(found == expected);
+    };
+
+    "maximal"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        /*
+         * Two stacked tiles of the same body next to a tall tile split the
+         * space to their left, the edge along the tall tile is a single run.
+         *
+         *   +----+----+
+         *   |    | 1  |
+         *   | 2  +----+
+         *   |    | 1  |
+         *   +----+----+
+         */
+
+        cento::insertTile(plane, {.id = 2, .rect = {{0, 0}, {10, 20}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{10, 0}, {20, 10}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{10, 10}, {20, 20}}});
+
+        i32 count = 0;
+        cento::enumerateEdges(plane, {{-5, -5}, {25, 25}}, [&](const cento::Edge& e)
+        {
+            if ((e.axis == cento::Axis::Vertical) && (e.from.x == 10))
+            {
+                expect(e.from == cento::Point{10, 0});
+                expect(e.to == cento::Point{10, 20});
+                ++count;
+            }
+        });
+        expect(count == 1_i);
+    };
+
+    "brute"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        for (i32 y = 0; y < 6; ++y)
+        {
+            for (i32 x = 0; x < 6; ++x)
+            {
+                const i32 w = 2 + ((x * 7 + y * 3) % 5);
+                const i32 h = 2 + ((x * 5 + y * 11) % 6);
+                const u64 id = u64((x + y) % 3);
+                cento::insertTile(plane, {.id = id, .rect = {{x * 7, y * 7}, {x * 7 + w, y * 7 + h}}});
+            }
+        }
+        // abutting tiles
+        cento::insertTile(plane, {.id = 5, .rect = {{-6, 0}, {0, 13}}});
+        cento::insertTile(plane, {.id = 5, .rect = {{-6, 13}, {0, 20}}});
+
+        for (const cento::Rect& area : {cento::Rect{{-10, -10}, {50, 50}},
+                                        cento::Rect{{3, 4}, {31, 29}},
+                                        cento::Rect{{-3, 11}, {9, 17}}})
+        {
+            std::vector<cento::Edge> found;
+            cento::enumerateEdges(plane, area, [&](const cento::Edge& e)
+            {
+                found.push_back(e);
+            });
+            std::ranges::sort(found, {}, key);
+
+            expect(found == bruteEdges(plane, area));
+        }
+    };
+};
@@ -329,3 +329,88 @@ suite query = []()
         expect(count == 9_i);
     };
 };
+
+suite query_solid = []()
+{
+    /*
+     * +-----------------------------+ - max
+     * |                             |
+     * |           above             |
+     * |                             |
+     * +---------+---------+---------+ - 256
+     * |         |         |         |
+     * |  left   | center  |  right  | - 0
+     * |         |         |         |
+     * +---------+---------+---------+ - -256
+     * |                             |
+     * |           below             |
+     * |                             |
+     * +-----------------------------+ - min
+     *
+     * m         -    0    2         m
+     * i         2         5         a
+     * n         5         6         x
+     *           6
+     *
+     */
+
+    constexpr const i32 min = cento::nInfinity;
+    constexpr const i32 max = cento::pInfinity;
+
+    const TilingPlan plan =
+    {
+        // center
+        {.id   = 0,
+         .rect = {.ll = {.x = -256, .y = -256}, .ur = {.x = 256, .y = 256}}},
+        // below
+        {.id   = cento::Space,
+         .rect = {.ll = {.x = min, .y = min}, .ur = {.x = max, .y = -256}}},
+        // left
+        {.id   = cento::Space,
+         .rect = {.ll = {.x = min, .y = -256}, .ur = {.x = -256, .y = 256}}},
+        // right
+        {.id   = cento::Space,
+         .rect = {.ll = {.x = 256, .y = -256}, .ur = {.x = max, .y = 256}}},
+        // above
+        {.id   = cento::Space,
+         .rect = {.ll = {.x = min, .y = 256}, .ur = {.x = max, .y = max}}},
+    };
+
+    const cento::Rect area = {.ll = {.x = -512, .y = -512},
+                              .ur = {.x = 512, .y = 512}};
+
+    "skips_space"_test = [&]()
+    {
+        cento::Plane plane;
+        const TileVec tiles = createTiles(plane, plan);
+
+        i32 all = 0;
+        cento::query(plane, area, [&](cento::Tile*) { ++all; });
+        expect(all == 5_i);
+
+        TileVec solid;
+        cento::querySolid(plane, area, [&](cento::Tile* t) { solid.push_back(t); });
+        expect(solid.size() == 1);
+        expect(solid.front() == tiles[0]);
+    };
+
+    "count"_test = [&]()
+    {
+        cento::Plane plane;
+        createTiles(plane, plan);
+
+        expect(cento::countSolid(plane, area) == 1);
+        expect(cento::countSolid(plane, {.ll = {-500, -128}, .ur = {-300, 128}}) == 0);
+    };
+
+    "any"_test = [&]()
+    {
+        cento::Plane plane;
+        createTiles(plane, plan);
+
+        expect(cento::anySolid(plane, area));
+        expect(cento::anySolid(plane, {.ll = {-300, -128}, .ur = {-255, 128}}));
+        expect(not cento::anySolid(plane, {.ll = {-500, -128}, .ur = {-300, 128}}));
+        expect(not cento::anySolid(plane, {.ll = {256, 0}, .ur = {512, 256}}));
+    };
+};
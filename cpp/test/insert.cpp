@@ -37,4 +37,33 @@ suite insert = []()
         expect(rightTop(tile)->id   == cento::Space);
         expect(topRight(tile)->id   == cento::Space);
     };
+
+    "abutting"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // a shorter tile placed against the left edge of a taller one must not
+        // split it at its own top edge
+        const cento::Tile* const tall  = cento::insertTile(plane, {.id = 1, .rect = {{180, 72}, {213, 175}}});
+        const cento::Tile* const other = cento::insertTile(plane, {.id = 2, .rect = {{168, 58}, {180, 152}}});
+
+        expect(getRect(tall)  == cento::Rect{{180, 72}, {213, 175}});
+        expect(getRect(other) == cento::Rect{{168, 58}, {180, 152}});
+    };
+
+    "stacked"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // a tile placed over a gap of the same width must not take in the
+        // space of the gap below it
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{20, 0}, {30, 10}}});
+        const cento::Tile* const top = cento::insertTile(plane, {.id = 2, .rect = {{10, 10}, {20, 20}}});
+
+        expect(getRect(top) == cento::Rect{{10, 10}, {20, 20}});
+        expect(isSpace(cento::findTileAt(plane, {15, 5})));
+    };
 };
@@ -0,0 +1,92 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoNearest.hpp"
+
+#include "utils.hpp"
+
+using namespace boost::ut;
+
+suite nearest = []()
+{
+    "universe"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        expect(cento::nearestSolid(plane, {0, 0}, 1000) == nullptr);
+        expect(cento::kNearestSolid(plane, {0, 0}, 4, 1000).empty());
+    };
+
+    "inside"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        const cento::Tile* const t = cento::insertTile(plane, {.id = 0, .rect = {{0, 0}, {10, 10}}});
+
+        expect(cento::nearestSolid(plane, {5, 5}, 0) == t);
+    };
+
+    "closest"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        /*
+         *            +---+
+         *            | 1 |
+         *            +---+
+         *
+         *   +---+      x         +---+
+         *   | 0 |                | 2 |
+         *   +---+                +---+
+         *
+         *                  +---+
+         *                  | 3 |
+         *                  +---+
+         */
+
+        cento::Tile* const t0 = cento::insertTile(plane, {.id = 0, .rect = {{-100, -10}, {-80, 10}}});
+        cento::Tile* const t1 = cento::insertTile(plane, {.id = 1, .rect = {{-20, 40}, {0, 60}}});
+        cento::Tile* const t2 = cento::insertTile(plane, {.id = 2, .rect = {{150, -10}, {170, 10}}});
+        cento::Tile* const t3 = cento::insertTile(plane, {.id = 3, .rect = {{50, -90}, {70, -70}}});
+
+        const cento::Point p{0, 0};
+
+        expect(cento::nearestSolid(plane, p, 1000) == t1);
+        expect(cento::nearestSolid(plane, p, 39) == nullptr);
+
+        const std::vector<cento::Tile*> all = cento::kNearestSolid(plane, p, 8, 1000);
+        expect(all == std::vector<cento::Tile*>{t1, t0, t3, t2});
+
+        const std::vector<cento::Tile*> two = cento::kNearestSolid(plane, p, 2, 1000);
+        expect(two == std::vector<cento::Tile*>{t1, t0});
+
+        // only the tiles within range are returned
+        const std::vector<cento::Tile*> near = cento::kNearestSolid(plane, p, 8, 85);
+        expect(near == std::vector<cento::Tile*>{t1, t0});
+    };
+
+    "behind"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // a wall of tiles between the point and a closer tile behind it
+        cento::Tile* const wall = cento::insertTile(plane, {.id = 0, .rect = {{10, -100}, {20, 100}}});
+        cento::Tile* const back = cento::insertTile(plane, {.id = 1, .rect = {{30, -5}, {40, 5}}});
+
+        const std::vector<cento::Tile*> found = cento::kNearestSolid(plane, {0, 0}, 2, 100);
+        expect(found == std::vector<cento::Tile*>{wall, back});
+    };
+};
@@ -0,0 +1,111 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoObserve.hpp"
+#include "cento/centoRemove.hpp"
+
+#include "utils.hpp"
+
+using namespace boost::ut;
+
+suite observe = []()
+{
+    using cento::Change;
+    using cento::Rect;
+
+    "body"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        std::vector<Rect> seen;
+        cento::watch(plane, {{0, 0}, {100, 100}}, Change::Body, [&](const Rect& r, Change kinds)
+        {
+            expect(kinds == Change::Body);
+            seen.push_back(r);
+        });
+
+        cento::Tile* const inside = cento::insertTile(plane, {.id = 0, .rect = {{10, 10}, {20, 20}}});
+        expect(seen == std::vector<Rect>{{{10, 10}, {20, 20}}});
+
+        // outside of the watched area
+        cento::insertTile(plane, {.id = 1, .rect = {{200, 10}, {220, 20}}});
+        expect(seen.size() == 1);
+
+        // clipped to the watched area
+        cento::insertTile(plane, {.id = 2, .rect = {{90, 50}, {120, 60}}});
+        expect(seen.size() == 2);
+        expect(seen.back() == Rect{{90, 50}, {100, 60}});
+
+        cento::removeTile(plane, inside);
+        expect(seen.size() == 3);
+        expect(seen.back() == Rect{{10, 10}, {20, 20}});
+    };
+
+    "batched"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        i32    calls = 0;
+        Change kinds = Change::None;
+        cento::watch(plane, {{-1000, -1000}, {1000, 1000}}, [&](const Rect&, Change k)
+        {
+            ++calls;
+            kinds = k;
+        });
+
+        // a single insert splits and merges several tiles but is reported once
+        cento::insertTile(plane, {.id = 0, .rect = {{10, 10}, {20, 20}}});
+        expect(calls == 1_i);
+        expect((kinds & Change::Split) == Change::Split);
+        expect((kinds & Change::Body) == Change::Body);
+    };
+
+    "distant"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        std::vector<Rect> seen;
+        cento::watch(plane, {{0, 0}, {100, 100}}, [&](const Rect& r, Change) { seen.push_back(r); });
+
+        // the strips of space split and merged by an edit far away run across
+        // the watched area, but nothing inside of it has changed
+        cento::Tile* const far = cento::insertTile(plane, {.id = 0, .rect = {{100000, 10}, {100020, 20}}});
+        cento::removeTile(plane, far);
+        expect(seen.empty());
+
+        // an edit inside is told only as the area it changed
+        cento::insertTile(plane, {.id = 1, .rect = {{10, 10}, {20, 20}}});
+        expect(seen == std::vector<Rect>{{{10, 10}, {20, 20}}});
+    };
+
+    "unwatch"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        i32 calls = 0;
+        const cento::WatchId id = cento::watch(plane, {{0, 0}, {100, 100}}, [&](const Rect&, Change)
+        {
+            ++calls;
+        });
+
+        cento::insertTile(plane, {.id = 0, .rect = {{10, 10}, {20, 20}}});
+        expect(calls == 1_i);
+
+        cento::unwatch(plane, id);
+        cento::insertTile(plane, {.id = 1, .rect = {{30, 10}, {40, 20}}});
+        expect(calls == 1_i);
+    };
+};
@@ -0,0 +1,225 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoPartition.hpp"
+#include "cento/centoRemove.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    using Layout = std::vector<std::tuple<i32, i32, i32, i32, u64>>;
+
+    const cento::Rect everywhere{{-1000, -1000}, {1000, 1000}};
+
+    Layout layoutOf(const cento::Plane& plane)
+    {
+        Layout layout;
+        cento::querySolid(plane, everywhere, [&](cento::Tile* t)
+        {
+            const cento::Rect r = getRect(t);
+            layout.emplace_back(r.ll.x, r.ll.y, r.ur.x, r.ur.y, t->id);
+        });
+        std::ranges::sort(layout);
+
+        return layout;
+    }
+
+    Layout layoutOf(const cento::PartitionedPlane& pp, const cento::Rect& area = everywhere)
+    {
+        Layout layout;
+        cento::querySolid(pp, area, [&](cento::Tile* t)
+        {
+            const cento::Rect r = cento::getRect(pp, t);
+            layout.emplace_back(r.ll.x, r.ll.y, r.ur.x, r.ur.y, t->id);
+        });
+        std::ranges::sort(layout);
+
+        return layout;
+    }
+
+}
+
+suite partition = []()
+{
+    const std::array<i32, 3> cuts{100, 200, 300};
+
+    "seam"_test = []()
+    {
+        const std::array<i32, 3> cuts{100, 200, 300};
+
+        cento::PartitionedPlane pp;
+        cento::createUniverse(pp, cuts);
+
+        // a tile crossing all three cuts
+        cento::Tile* const t = cento::insertTile(pp, {.id = 1, .rect = {{0, 50}, {10, 350}}});
+        expect(t != nullptr);
+        expect(getRect(t) == cento::Rect{{0, 50}, {10, 100}});
+        expect(cento::getRect(pp, t) == cento::Rect{{0, 50}, {10, 350}});
+
+        expect(cento::insertTile(pp, {.id = 2, .rect = {{5, 250}, {20, 260}}}) == nullptr);
+        expect(not cento::empty(pp, {{-5, 220}, {5, 230}}));
+
+        const cento::Tile* const mid = cento::findTileAt(pp, {5, 250});
+        expect(mid->id == 1);
+        expect(cento::getRect(pp, mid) == cento::Rect{{0, 50}, {10, 350}});
+
+        expect(layoutOf(pp) == Layout{{0, 50, 10, 350, 1}});
+        expect(layoutOf(pp, {{0, 150}, {50, 250}}) == Layout{{0, 50, 10, 350, 1}});
+
+        // removing through any of the pieces removes the whole tile
+        cento::removeTile(pp, cento::findTileAt(pp, {5, 320}));
+        expect(layoutOf(pp).empty());
+        expect(cento::empty(pp, everywhere));
+    };
+
+    "abutting"_test = [&]()
+    {
+        cento::PartitionedPlane pp;
+        cento::createUniverse(pp, cuts);
+
+        // two tiles of the same body and width meeting at a cut, and one which
+        // crosses the next cut over the same span
+        cento::Tile* const lower = cento::insertTile(pp, {.id = 1, .rect = {{0, 50}, {10, 100}}});
+        cento::Tile* const upper = cento::insertTile(pp, {.id = 1, .rect = {{0, 100}, {10, 150}}});
+        cento::Tile* const cross = cento::insertTile(pp, {.id = 1, .rect = {{0, 150}, {10, 250}}});
+        expect(lower && upper && cross);
+
+        expect(cento::getRect(pp, lower) == cento::Rect{{0, 50}, {10, 100}});
+        expect(cento::getRect(pp, upper) == cento::Rect{{0, 100}, {10, 150}});
+        expect(cento::getRect(pp, cento::findTileAt(pp, {5, 220})) == cento::Rect{{0, 150}, {10, 250}});
+        expect(layoutOf(pp) == Layout{{0, 50, 10, 100, 1}, {0, 100, 10, 150, 1}, {0, 150, 10, 250, 1}});
+
+        // removing one leaves the other whole
+        cento::removeTile(pp, upper);
+        expect(layoutOf(pp) == Layout{{0, 50, 10, 100, 1}, {0, 150, 10, 250, 1}});
+
+        cento::removeTile(pp, cento::findTileAt(pp, {5, 60}));
+        expect(layoutOf(pp) == Layout{{0, 150, 10, 250, 1}});
+
+        // and the crossing is forgotten with its tile
+        cento::removeTile(pp, cento::findTileAt(pp, {5, 160}));
+        expect(cento::insertTile(pp, {.id = 1, .rect = {{0, 190}, {10, 200}}}) != nullptr);
+        expect(cento::insertTile(pp, {.id = 1, .rect = {{0, 200}, {10, 210}}}) != nullptr);
+        expect(layoutOf(pp) == Layout{{0, 190, 10, 200, 1}, {0, 200, 10, 210, 1}});
+    };
+
+    "matches_plane"_test = [&]()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::PartitionedPlane pp;
+        cento::createUniverse(pp, cuts);
+
+        std::vector<std::pair<cento::Tile*, cento::Tile*>> tiles;
+
+        u32 seed = 7;
+        auto next = [&]() { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+
+        for (u64 id = 0; id < 600; ++id)
+        {
+            if (not tiles.empty() && (next() % 3 == 0))
+            {
+                const usize i = next() % tiles.size();
+                cento::removeTile(plane, tiles[i].first);
+                cento::removeTile(pp, tiles[i].second);
+                tiles.erase(tiles.begin() + i);
+                continue;
+            }
+
+            const i32 x = i32(next() % 400);
+            const i32 y = i32(next() % 400);
+            const i32 w = i32(next() % 40) + 1;
+            const i32 h = i32(next() % 120) + 1;
+            const cento::TilePlan plan{.id = id, .rect = {{x, y}, {x + w, y + h}}};
+
+            cento::Tile* const a = cento::insertTile(plane, plan);
+            cento::Tile* const b = cento::insertTile(pp, plan);
+            expect((a == nullptr) == (b == nullptr));
+            if (a && b) { tiles.emplace_back(a, b); }
+        }
+
+        expect(layoutOf(pp) == layoutOf(plane));
+
+        for (const auto& [a, b] : tiles)
+        {
+            const cento::Point p = getRect(a).ll;
+            expect(cento::findTileAt(pp, p)->id == a->id);
+        }
+    };
+
+    "parallel"_test = [&]()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::PartitionedPlane pp;
+        cento::createUniverse(pp, cuts);
+
+        // one thread per band inserting and removing within its band, plus one
+        // more placing tiles across the cuts in a column of its own
+        auto worker = [&](const i32 band)
+        {
+            std::vector<cento::Tile*> mine;
+            for (i32 i = 0; i < 100; ++i)
+            {
+                const i32 x = (i % 10) * 40;
+                const i32 y = band * 100 + (i / 10) * 10;
+                mine.push_back(cento::insertTile(pp, {.id = u64(band), .rect = {{x, y}, {x + 30, y + 5}}}));
+            }
+            for (usize i = 0; i < mine.size(); i += 2) { cento::removeTile(pp, mine[i]); }
+        };
+
+        auto crossing = [&]()
+        {
+            for (i32 i = 0; i < 20; ++i)
+            {
+                const i32 x = 500 + i * 20;
+                cento::Tile* const t = cento::insertTile(pp, {.id = 9, .rect = {{x, 50}, {x + 10, 350}}});
+                if (i % 2 == 0) { cento::removeTile(pp, t); }
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            for (i32 band = 0; band < 4; ++band) { threads.emplace_back(worker, band); }
+            threads.emplace_back(crossing);
+        }
+
+        for (i32 band = 0; band < 4; ++band)
+        {
+            for (i32 i = 1; i < 100; i += 2)
+            {
+                const i32 x = (i % 10) * 40;
+                const i32 y = band * 100 + (i / 10) * 10;
+                cento::insertTile(plane, {.id = u64(band), .rect = {{x, y}, {x + 30, y + 5}}});
+            }
+        }
+        for (i32 i = 1; i < 20; i += 2)
+        {
+            const i32 x = 500 + i * 20;
+            cento::insertTile(plane, {.id = 9, .rect = {{x, 50}, {x + 10, 350}}});
+        }
+
+        expect(layoutOf(pp) == layoutOf(plane));
+    };
+};
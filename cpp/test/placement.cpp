@@ -0,0 +1,209 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCell.hpp"
+#include "cento/centoIndex.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    std::vector<u32> found(const cento::PlacementIndex& index, const cento::Rect& window)
+    {
+        std::vector<u32> items;
+        cento::queryBoxes(index, window, [&](const u32 i) { items.push_back(i); });
+        std::ranges::sort(items);
+
+        return items;
+    }
+
+    std::vector<u32> expected(const std::vector<cento::Rect>& boxes, const cento::Rect& window)
+    {
+        std::vector<u32> items;
+        for (u32 i = 0; i < boxes.size(); ++i)
+        {
+            if (overlaps(boxes[i], window)) { items.push_back(i); }
+        }
+
+        return items;
+    }
+
+}
+
+suite placement = []()
+{
+    "overlapping"_test = []()
+    {
+        cento::PlacementIndex index;
+        cento::createUniverse(index);
+
+        cento::insertBox(index, 0, {{0, 0}, {100, 100}});
+        cento::insertBox(index, 1, {{50, 50}, {150, 150}});
+        cento::insertBox(index, 2, {{200, 0}, {250, 50}});
+
+        expect(found(index, {{10, 10}, {20, 20}}) == std::vector<u32>{0});
+        expect(found(index, {{60, 60}, {70, 70}}) == std::vector<u32>{0, 1});
+        expect(found(index, {{120, 0}, {300, 40}}) == std::vector<u32>{2});
+        expect(found(index, {{160, 60}, {190, 200}}).empty());
+
+        // the space the boxes share is one tile listing both
+        const cento::Tile* const shared = cento::findTileAt(index.plane, {75, 75});
+        expect(index.lists[shared->id].size() == 2);
+
+        cento::eraseBox(index, 0);
+        expect(found(index, {{10, 10}, {20, 20}}).empty());
+        expect(found(index, {{60, 60}, {70, 70}}) == std::vector<u32>{1});
+
+        cento::moveBox(index, 2, {{-50, -50}, {-10, -10}});
+        expect(found(index, {{120, 0}, {300, 40}}).empty());
+        expect(found(index, {{-20, -20}, {0, 0}}) == std::vector<u32>{2});
+
+        // the tile box 0 was drawn as still lists box 1 until it goes too
+        cento::eraseBox(index, 1);
+        expect(isSpace(cento::findTileAt(index.plane, {10, 10})));
+    };
+
+    "coalesce"_test = []()
+    {
+        cento::PlacementIndex index;
+        cento::createUniverse(index);
+
+        // the large box is drawn around the small one in several pieces
+        cento::insertBox(index, 0, {{40, 40}, {60, 60}});
+        cento::insertBox(index, 1, {{0, 0}, {100, 100}});
+        cento::insertBox(index, 2, {{200, 0}, {300, 100}});
+        expect(cento::countSolid(index.plane, {{0, 0}, {300, 100}}) > 2);
+
+        // once the small box goes the pieces are joined up again
+        cento::eraseBox(index, 0);
+        expect(cento::countSolid(index.plane, {{0, 0}, {300, 100}}) == 2);
+        expect(getRect(cento::findTileAt(index.plane, {50, 50})) == cento::Rect{{0, 0}, {100, 100}});
+        expect(found(index, {{50, 50}, {51, 51}}) == std::vector<u32>{1});
+
+        // however often a box is drawn around another it is joined up again
+        for (i32 x = 0; x < 100; x += 10)
+        {
+            cento::insertBox(index, 0, {{x + 20, 30 + x / 4}, {x + 40, 70}});
+            cento::moveBox(index, 1, {{x, 0}, {x + 100, 100}});
+            cento::eraseBox(index, 0);
+            expect(cento::countSolid(index.plane, {{-100, -100}, {400, 200}}) == 2);
+        }
+    };
+
+    "candidates"_test = []()
+    {
+        cento::PlacementIndex index;
+        cento::createUniverse(index);
+
+        // a large box added first, then a grid of small ones inside of it
+        cento::insertBox(index, 0, {{0, 0}, {1000, 1000}});
+        u32 item = 1;
+        for (i32 y = 0; y < 1000; y += 50)
+        {
+            for (i32 x = 0; x < 1000; x += 50) { cento::insertBox(index, item++, {{x + 10, y + 10}, {x + 20, y + 20}}); }
+        }
+
+        // the items listed by the tiles a small window walks are only those
+        // whose boxes cover them
+        auto visited = [&](const cento::Rect& window)
+        {
+            usize candidates = 0;
+            cento::querySolid(index.plane, window, [&](cento::Tile* t) { candidates += index.lists[t->id].size(); });
+            return candidates;
+        };
+        expect(visited({{515, 515}, {516, 516}}) == 2);
+        expect(visited({{530, 530}, {531, 531}}) == 1);
+        expect(found(index, {{515, 515}, {516, 516}}) == std::vector<u32>{0, 10 * 20 + 10 + 1});
+
+        // erasing the small boxes joins the large one up again
+        for (u32 i = 1; i < item; ++i) { cento::eraseBox(index, i); }
+        expect(cento::countSolid(index.plane, {{0, 0}, {1000, 1000}}) == 1);
+    };
+
+    "random"_test = []()
+    {
+        std::mt19937                       rng(7);
+        std::uniform_int_distribution<i32> pos(-500, 500);
+        std::uniform_int_distribution<i32> size(1, 120);
+
+        auto box = [&]()
+        {
+            const cento::Point ll{pos(rng), pos(rng)};
+            return cento::Rect{ll, {ll.x + size(rng), ll.y + size(rng)}};
+        };
+
+        cento::PlacementIndex index;
+        cento::createUniverse(index);
+
+        std::vector<cento::Rect> boxes;
+        for (u32 i = 0; i < 200; ++i)
+        {
+            boxes.push_back(box());
+            cento::insertBox(index, i, boxes.back());
+        }
+
+        // move boxes about, every window must still find what overlaps it
+        for (u32 round = 0; round < 200; ++round)
+        {
+            const u32 i = round % 200;
+            boxes[i]    = box();
+            cento::moveBox(index, i, boxes[i]);
+
+            const cento::Rect window = box();
+            expect(found(index, window) == expected(boxes, window));
+        }
+
+        // once every box is gone the plane is empty again
+        for (u32 i = 0; i < 200; ++i) { cento::eraseBox(index, i); }
+
+        usize tiles = 0;
+        cento::queryAll(index.plane, [&](cento::Tile*) { ++tiles; });
+        expect(tiles == 1);
+    };
+
+    "cell"_test = []()
+    {
+        cento::Cell pad;
+        cento::createUniverse(pad);
+        cento::insertTile(pad, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+
+        cento::Cell top;
+        cento::createUniverse(top);
+        cento::place(top, pad, {0, 0});
+        cento::place(top, pad, {100, 0});
+
+        // moving a placement moves what queries find
+        cento::movePlacement(top, 0, {300, 300});
+
+        usize count = 0;
+        cento::queryCell(top, {{-5, -5}, {5, 5}}, [&](cento::Tile*, const cento::Point&) { ++count; });
+        expect(count == 0);
+
+        std::vector<cento::Rect> rects;
+        cento::queryCell(top, {{0, 0}, {400, 400}}, [&](cento::Tile* t, const cento::Point& offset)
+        {
+            rects.push_back(translate(getRect(t), offset));
+        });
+        std::ranges::sort(rects);
+        expect(rects == std::vector<cento::Rect>{{{100, 0}, {110, 10}}, {{300, 300}, {310, 310}}});
+        expect(top.bounds == cento::Rect{{100, 0}, {310, 310}});
+
+        // moving it back in shrinks the bounds again
+        cento::movePlacement(top, 0, {120, 5});
+        expect(top.bounds == cento::Rect{{100, 0}, {130, 15}});
+    };
+};
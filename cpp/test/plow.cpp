@@ -0,0 +1,183 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoExplore.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoPlow.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    std::map<u64, cento::Rect> solids(const cento::Plane& plane)
+    {
+        std::map<u64, cento::Rect> all;
+        cento::queryAll(plane, [&](cento::Tile* t)
+        {
+            if (isSolid(t)) { all.emplace(t->id, getRect(t)); }
+        });
+
+        return all;
+    }
+
+    std::vector<cento::Rect> tilesOf(const cento::Plane& plane, const u64 id)
+    {
+        std::vector<cento::Rect> all;
+        cento::queryAll(plane, [&](cento::Tile* t)
+        {
+            if (isSolid(t) && (t->id == id)) { all.push_back(getRect(t)); }
+        });
+        std::ranges::sort(all, {}, [](const cento::Rect& r) { return std::pair{r.ll.y, r.ll.x}; });
+
+        return all;
+    }
+
+}
+
+suite plow = []()
+{
+    "right"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{10, 0}, {20, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{25, 0}, {35, 10}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{50, 5}, {60, 15}}});
+        cento::insertTile(plane, {.id = 4, .rect = {{10, 30}, {20, 40}}});
+
+        const usize moved = cento::plow(plane, {{5, 0}, {5, 10}}, 10, [](u64, u64) { return 2; }, 2);
+        expect(moved == 2);
+
+        // the first tile is shoved to the far side of the plow and shoves the
+        // second along, the third is still far enough away
+        const std::map<u64, cento::Rect> after = solids(plane);
+        expect(after.at(1) == cento::Rect{{15, 0}, {25, 10}});
+        expect(after.at(2) == cento::Rect{{27, 0}, {37, 10}});
+        expect(after.at(3) == cento::Rect{{50, 5}, {60, 15}});
+        expect(after.at(4) == cento::Rect{{10, 30}, {20, 40}});
+    };
+
+    "down"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // the plow starts inside the first tile so it is carried the whole way
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 40}, {10, 60}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{5, 20}, {30, 35}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{25, 0}, {40, 10}}});
+
+        const usize moved = cento::plow(plane, {{0, 50}, {10, 50}}, -20, [](u64, u64) { return 5; }, 5);
+        expect(moved == 3);
+
+        const std::map<u64, cento::Rect> after = solids(plane);
+        expect(after.at(1) == cento::Rect{{0, 20}, {10, 40}});
+        expect(after.at(2) == cento::Rect{{5, 0}, {30, 15}});
+        expect(after.at(3) == cento::Rect{{25, -15}, {40, -5}});
+    };
+
+    "shape"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // an L of two tiles, only its foot in the way of the plow
+        cento::insertTile(plane, {.id = 1, .rect = {{10, 0}, {20, 10}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{10, 10}, {40, 20}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{45, 12}, {55, 20}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{45, 0}, {55, 8}}});
+
+        const usize moved = cento::plow(plane, {{5, 0}, {5, 10}}, 10, [](u64, u64) { return 2; }, 2);
+        expect(moved == 3);
+
+        // the arm goes along with the foot and pushes on what it faces
+        expect(tilesOf(plane, 1) == std::vector<cento::Rect>{{{15, 0}, {25, 10}}, {{15, 10}, {45, 20}}});
+        expect(tilesOf(plane, 2) == std::vector<cento::Rect>{{{47, 12}, {57, 20}}});
+        expect(tilesOf(plane, 3) == std::vector<cento::Rect>{{{45, 0}, {55, 8}}});
+    };
+
+    "around"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // a U around a tile nearer to it than the spacing on either side
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {5, 30}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{5, 0}, {25, 5}}});
+        cento::insertTile(plane, {.id = 1, .rect = {{25, 0}, {30, 30}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{7, 10}, {23, 20}}});
+
+        const usize moved = cento::plow(plane, {{-5, 0}, {-5, 30}}, 10, [](u64, u64) { return 4; }, 4);
+        expect(moved == 4);
+
+        // the two push each other only as far as the plow pushed the U
+        const std::vector<cento::Rect> u = tilesOf(plane, 1);
+        expect(std::ranges::all_of(u, [](const cento::Rect& r) { return r.ll.x >= 5 && r.ur.x <= 35; }));
+        expect(cento::countSolid(plane, {{5, 0}, {35, 30}}) == u.size() + 1);
+        expect(tilesOf(plane, 2) == std::vector<cento::Rect>{{{12, 10}, {28, 20}}});
+    };
+
+    "random"_test = []()
+    {
+        std::mt19937                       rng(5);
+        std::uniform_int_distribution<i32> pos(0, 1000);
+        std::uniform_int_distribution<i32> size(1, 40);
+
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        for (u64 id = 0; id < 300; ++id)
+        {
+            const cento::Point ll{pos(rng), pos(rng)};
+            cento::insertTile(plane, {.id = id, .rect = {ll, {ll.x + size(rng), ll.y + size(rng)}}});
+        }
+        const std::map<u64, cento::Rect> before = solids(plane);
+
+        cento::plow(plane, {{300, 200}, {300, 700}}, -150, [](u64, u64) { return 4; }, 4);
+
+        const std::map<u64, cento::Rect> after = solids(plane);
+        expect(after.size() == before.size());
+
+        // nothing is left in the swept area, those the plow started inside are
+        // carried the whole way, and no pair which kept their spacing before
+        // has lost it
+        bool swept  = true;
+        bool spaced = true;
+        for (const auto& [id, r] : after)
+        {
+            const cento::Rect& was = before.at(id);
+            if ((was.ll.y < 700) && (was.ur.y > 200) && (was.ur.x > 150))
+            {
+                if (was.ur.x <= 300) { swept = swept && (r.ur.x <= 150); }
+                else if (was.ll.x < 300) { swept = swept && (r.ll.x == was.ll.x - 150); }
+            }
+
+            for (const auto& [other, o] : after)
+            {
+                const cento::Rect& owas = before.at(other);
+                const bool rows = (owas.ll.y < was.ur.y) && (was.ll.y < owas.ur.y);
+                if (not rows || (owas.ur.x > was.ll.x)) { continue; }
+
+                if (was.ll.x >= owas.ur.x + 4) { spaced = spaced && (r.ll.x >= o.ur.x + 4); }
+            }
+        }
+        expect(swept);
+        expect(spaced);
+    };
+};
@@ -0,0 +1,98 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoExplore.hpp"
+#include "cento/centoQueue.hpp"
+
+#include "utils.hpp"
+
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace boost::ut;
+
+suite queue = []()
+{
+    "producers"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        {
+            cento::EditQueue edits(plane, 16);
+
+            // each producer fills a column of its own, pushing from the top
+            // down so that the applier has something to sort
+            std::vector<std::thread> producers;
+            for (i32 p = 0; p < 4; ++p)
+            {
+                producers.emplace_back([&edits, p]()
+                {
+                    std::vector<std::future<cento::Tile*>> placed;
+                    for (i32 y = 63; y >= 0; --y)
+                    {
+                        const cento::Rect r{{p * 100, y * 10}, {p * 100 + 50, y * 10 + 5}};
+                        placed.push_back(cento::insertTile(edits, {.id = u64(p), .rect = r}));
+                    }
+
+                    for (std::future<cento::Tile*>& f : placed) { expect(f.get() != nullptr); }
+                });
+            }
+            for (std::thread& t : producers) { t.join(); }
+
+            flush(edits);
+            expect(cento::countSolid(plane, {{-10, -10}, {400, 700}}) == 256);
+        }
+    };
+
+    "ordering"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::EditQueue edits(plane);
+
+        // overlapping edits are applied in the order they were pushed
+        std::future<cento::Tile*> first  = cento::insertTile(edits, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        std::future<cento::Tile*> second = cento::insertTile(edits, {.id = 2, .rect = {{5, 5}, {15, 15}}});
+        std::future<cento::Tile*> apart  = cento::insertTile(edits, {.id = 3, .rect = {{-50, -50}, {-40, -40}}});
+
+        cento::Tile* const tile = first.get();
+        expect(tile != nullptr);
+        expect(second.get() == nullptr);
+        expect(apart.get() != nullptr);
+
+        cento::removeTile(edits, tile).get();
+        std::future<cento::Tile*> again = cento::insertTile(edits, {.id = 2, .rect = {{5, 5}, {15, 15}}});
+        expect(again.get() != nullptr);
+
+        flush(edits);
+        expect(cento::findTileAt(plane, {12, 12})->id == 2);
+        expect(isSpace(cento::findTileAt(plane, {2, 2})));
+    };
+
+    "flush"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::EditQueue edits(plane, 4);
+        for (i32 i = 0; i < 100; ++i)
+        {
+            // the futures are dropped, flush is the only wait
+            cento::insertTile(edits, {.id = 1, .rect = {{i * 20, 0}, {i * 20 + 10, 10}}});
+        }
+
+        flush(edits);
+        expect(cento::countSolid(plane, {{-10, -10}, {2000, 20}}) == 100);
+    };
+};
@@ -0,0 +1,122 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoRay.hpp"
+
+#include "utils.hpp"
+
+using namespace boost::ut;
+
+suite ray = []()
+{
+    "universe"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        expect(not cento::castRay(plane, {0, 0}, cento::Direction::Left, 1000));
+        expect(not cento::castRay(plane, {0, 0}, cento::Direction::Right, 1000));
+        expect(not cento::castRay(plane, {0, 0}, cento::Direction::Down, 1000));
+        expect(not cento::castRay(plane, {0, 0}, cento::Direction::Up, 1000));
+    };
+
+    "directions"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        /*
+         *             +---+
+         *             | u |
+         *             +---+
+         *
+         *   +---+  +---+ x      +---+
+         *   | l |  | n |        | r |
+         *   +---+  +---+        +---+
+         *
+         *             +---+
+         *             | d |
+         *             +---+
+         */
+
+        cento::Tile* const l = cento::insertTile(plane, {.id = 0, .rect = {{-100, -10}, {-80, 10}}});
+        cento::Tile* const n = cento::insertTile(plane, {.id = 1, .rect = {{-50, -10}, {-30, -1}}});
+        cento::Tile* const r = cento::insertTile(plane, {.id = 2, .rect = {{60, -10}, {80, 10}}});
+        cento::Tile* const u = cento::insertTile(plane, {.id = 3, .rect = {{-10, 40}, {10, 60}}});
+        cento::Tile* const d = cento::insertTile(plane, {.id = 4, .rect = {{-10, -90}, {10, -70}}});
+
+        const cento::Point o{0, 0};
+
+        // n lies just below the ray so it is missed
+        const cento::RayHit left = cento::castRay(plane, o, cento::Direction::Left, 1000);
+        expect(left.tile == l);
+        expect(left.hit == cento::Point{-80, 0});
+        expect(left.distance == 80_i);
+
+        const cento::RayHit right = cento::castRay(plane, o, cento::Direction::Right, 1000);
+        expect(right.tile == r);
+        expect(right.hit == cento::Point{60, 0});
+        expect(right.distance == 60_i);
+
+        const cento::RayHit up = cento::castRay(plane, o, cento::Direction::Up, 1000);
+        expect(up.tile == u);
+        expect(up.hit == cento::Point{0, 40});
+        expect(up.distance == 40_i);
+
+        const cento::RayHit down = cento::castRay(plane, o, cento::Direction::Down, 1000);
+        expect(down.tile == d);
+        expect(down.hit == cento::Point{0, -70});
+        expect(down.distance == 70_i);
+
+        // limits
+        expect(not cento::castRay(plane, o, cento::Direction::Right, 59));
+        expect(bool(cento::castRay(plane, o, cento::Direction::Right, 60)));
+
+        // inside
+        const cento::RayHit inside = cento::castRay(plane, {-40, -5}, cento::Direction::Up, 0);
+        expect(inside.tile == n);
+        expect(inside.distance == 0_i);
+    };
+
+    "batch"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        for (i32 x = 0; x < 32; ++x)
+        {
+            cento::insertTile(plane, {.id = u64(x), .rect = {{x * 20, 0}, {x * 20 + 10, 10}}});
+        }
+
+        std::vector<cento::Ray> rays;
+        for (i32 x = -5; x < 640; x += 3)
+        {
+            rays.push_back({.origin = {x, 5}, .direction = cento::Direction::Right, .limit = 100});
+            rays.push_back({.origin = {x, 50}, .direction = cento::Direction::Down, .limit = 100});
+        }
+
+        const cento::Tile* const hint = plane.hint;
+
+        const std::vector<cento::RayHit> hits = cento::castRays(plane, rays);
+        expect(hits.size() == rays.size());
+        expect(plane.hint == hint);
+
+        i32 mismatches = 0;
+        for (usize i = 0; i < rays.size(); ++i)
+        {
+            const cento::Ray&   r = rays[i];
+            const cento::RayHit h = cento::castRay(plane, r.origin, r.direction, r.limit);
+            if ((h.tile != hits[i].tile) || (h.hit != hits[i].hit)) { ++mismatches; }
+        }
+        expect(mismatches == 0_i);
+    };
+};
@@ -95,4 +95,22 @@ suite rect = []()
         expect(not contains(bl, brp));
         expect(    contains(br, brp));
     };
+
+    "overlaps"_test = []()
+    {
+        const Rect a{.ll = {.x = 0, .y = 0}, .ur = {.x = 256, .y = 256}};
+        const Rect b{.ll = {.x = 128, .y = 128}, .ur = {.x = 512, .y = 512}};
+        const Rect c{.ll = {.x = 256, .y = 0}, .ur = {.x = 512, .y = 256}};
+
+        expect(    overlaps(a, b));
+        expect(    overlaps(b, a));
+        expect(    overlaps(b, c));
+
+        // sharing an edge is not overlapping
+        expect(not overlaps(a, c));
+        expect(not overlaps(c, a));
+
+        expect(intersection(a, b) == Rect{.ll = {.x = 128, .y = 128}, .ur = {.x = 256, .y = 256}});
+        expect(boundingBox(a, c)  == Rect{.ll = {.x = 0, .y = 0}, .ur = {.x = 512, .y = 256}});
+    };
 };
@@ -8,6 +8,9 @@
 #include <boost/ut.hpp>
 
 #include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoExplore.hpp"
+#include "cento/centoInsert.hpp"
 #include "cento/centoRemove.hpp"
 
 #include "utils.hpp"
@@ -121,4 +124,61 @@ suite removeT = []()
         expect(plane.hint->id   == cento::Space);
         expect(plane.hint->rect == cento::Rect{{-256, -256}, {256, 256}});
     };
+
+    "tall_left"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // the solid tile to the left reaches above the deleted tile, the solid
+        // tile above must keep its shape
+        cento::insertTile(plane, {.id = 1, .rect = {{-10, 0}, {0, 20}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{0, 2}, {10, 30}}});
+        cento::Tile* const thin = cento::insertTile(plane, {.id = 3, .rect = {{0, 0}, {10, 2}}});
+
+        cento::removeTile(plane, thin);
+
+        expect(getRect(cento::findTileAt(plane, {5, 10})) == cento::Rect{{0, 2}, {10, 30}});
+        expect(isSpace(cento::findTileAt(plane, {5, 1})));
+    };
+
+    "stacked"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // the space to the right reaches below the deleted tile
+        cento::Tile* const lower = cento::insertTile(plane, {.id = 1, .rect = {{2, 4}, {4, 5}}});
+        cento::Tile* const upper = cento::insertTile(plane, {.id = 2, .rect = {{2, 5}, {4, 7}}});
+
+        cento::removeTile(plane, upper);
+        expect(getRect(cento::findTileAt(plane, {3, 6})) == cento::Rect{{cento::nInfinity, 5}, {cento::pInfinity, cento::pInfinity}});
+
+        cento::removeTile(plane, lower);
+        expect(getRect(cento::findTileAt(plane, {3, 6})) == cento::Rect{{cento::nInfinity, cento::nInfinity}, {cento::pInfinity, cento::pInfinity}});
+    };
+
+    "tall_space_left"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // the space to the upper left reaches above the deleted tile
+        cento::insertTile(plane, {.id = 1, .rect = {{12, 11}, {16, 14}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{1, 7}, {5, 10}}});
+        cento::Tile* const tall = cento::insertTile(plane, {.id = 3, .rect = {{8, 9}, {9, 14}}});
+        cento::insertTile(plane, {.id = 4, .rect = {{8, 14}, {12, 16}}});
+
+        cento::removeTile(plane, tall);
+
+        // no space tile may have space beside it
+        cento::queryAll(plane, [](cento::Tile* t)
+        {
+            if (isSolid(t)) { return; }
+            for (cento::Tile* r = topRight(t); (r != nullptr) && (getTop(r) > getBottom(t)); r = leftBottom(r))
+            {
+                expect(isSolid(r));
+            }
+        });
+    };
 };
@@ -0,0 +1,189 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoExplore.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoRoute.hpp"
+
+#include "utils.hpp"
+
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    // Every leg is straight and the wire along it touches nothing solid.
+    bool isClear(const cento::Plane& plane, const std::vector<cento::Point>& path, const i32 width)
+    {
+        for (usize i = 1; i < path.size(); ++i)
+        {
+            const cento::Point a = path[i - 1];
+            const cento::Point b = path[i];
+            if ((a.x != b.x) && (a.y != b.y)) { return false; }
+
+            const cento::Rect r{{std::min(a.x, b.x), std::min(a.y, b.y)}, {std::max(a.x, b.x) + width, std::max(a.y, b.y) + width}};
+            if (cento::anySolid(plane, r)) { return false; }
+        }
+
+        return true;
+    }
+
+    i64 length(const std::vector<cento::Point>& path)
+    {
+        i64 total = 0;
+        for (usize i = 1; i < path.size(); ++i)
+        {
+            total += std::abs(path[i].x - path[i - 1].x) + std::abs(path[i].y - path[i - 1].y);
+        }
+
+        return total;
+    }
+
+    // The shortest route of a wire of the width by a search of every point
+    // in the area, or -1 if there is none.
+    i64 gridRoute(const cento::Plane& plane, const cento::Rect& area, const cento::Point from, const cento::Point to, const i32 width)
+    {
+        const i32 w = area.ur.x - area.ll.x;
+        const i32 h = area.ur.y - area.ll.y;
+
+        std::vector<i64> dist(usize(w) * usize(h), -1);
+        auto at = [&](const cento::Point p) -> i64& { return dist[usize(p.y - area.ll.y) * usize(w) + usize(p.x - area.ll.x)]; };
+        auto ok = [&](const cento::Point p)
+        {
+            return cento::contains(area, p) && not cento::anySolid(plane, {p, {p.x + width, p.y + width}});
+        };
+
+        if (not ok(from) || not ok(to)) { return -1; }
+
+        std::deque<cento::Point> open = {from};
+        at(from) = 0;
+        while (not open.empty())
+        {
+            const cento::Point p = open.front();
+            open.pop_front();
+            if (p == to) { break; }
+
+            for (const cento::Point d : {cento::Point{1, 0}, cento::Point{-1, 0}, cento::Point{0, 1}, cento::Point{0, -1}})
+            {
+                const cento::Point n = cento::translate(p, d);
+                if (not ok(n) || (at(n) >= 0)) { continue; }
+
+                at(n) = at(p) + 1;
+                open.push_back(n);
+            }
+        }
+
+        return at(to);
+    }
+
+}
+
+suite route = []()
+{
+    "around"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{10, -20}, {20, 30}}});
+
+        const std::vector<cento::Point> path = cento::routePath(plane, {0, 0}, {30, 0}, 1);
+        expect(path.size() >= 2);
+        expect(path.front() == cento::Point{0, 0});
+        expect(path.back() == cento::Point{30, 0});
+        expect(isClear(plane, path, 1));
+
+        // the wall is gone round at its nearer end
+        expect(length(path) == 30 + 2 * 21);
+    };
+
+    "width"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        // a gap of three between two walls, closed off above and below
+        cento::insertTile(plane, {.id = 1, .rect = {{10, 0}, {20, 40}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{10, 43}, {20, 80}}});
+        cento::insertTile(plane, {.id = 3, .rect = {{-100, 80}, {100, 90}}});
+        cento::insertTile(plane, {.id = 4, .rect = {{-100, -10}, {100, 0}}});
+        cento::insertTile(plane, {.id = 5, .rect = {{-110, -10}, {-100, 90}}});
+        cento::insertTile(plane, {.id = 6, .rect = {{100, -10}, {110, 90}}});
+
+        const std::vector<cento::Point> thin = cento::routePath(plane, {0, 10}, {30, 10}, 3);
+        expect(not thin.empty());
+        expect(isClear(plane, thin, 3));
+
+        expect(cento::routePath(plane, {0, 10}, {30, 10}, 4).empty());
+
+        // committing the wire fills it in, so a second one cannot pass
+        expect(cento::commitPath(plane, thin, 3, 7));
+        expect(cento::anySolid(plane, {{12, 40}, {18, 43}}));
+        expect(cento::routePath(plane, {0, 10}, {30, 10}, 1).empty());
+        expect(not cento::commitPath(plane, thin, 3, 8));
+    };
+
+    "blocked"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+
+        expect(cento::routePath(plane, {5, 5}, {20, 20}, 1).empty());
+        expect(cento::routePath(plane, {-20, 0}, {-1, 0}, 2).empty());
+        expect(cento::routePath(plane, {20, 20}, {20, 20}, 1) == std::vector<cento::Point>{{20, 20}});
+    };
+
+    "random"_test = []()
+    {
+        std::mt19937                       rng(5);
+        std::uniform_int_distribution<i32> pos(0, 40);
+        std::uniform_int_distribution<i32> size(1, 12);
+
+        for (usize round = 0; round < 30; ++round)
+        {
+            cento::Plane plane;
+            cento::createUniverse(plane);
+            for (u64 id = 1; id <= 40; ++id)
+            {
+                const cento::Point ll{pos(rng), pos(rng)};
+                cento::insertTile(plane, {.id = id, .rect = {ll, {ll.x + size(rng), ll.y + size(rng)}}});
+            }
+
+            const i32          width = 1 + i32(round % 3);
+            const cento::Point from{pos(rng), pos(rng)};
+            const cento::Point to{pos(rng), pos(rng)};
+
+            const std::vector<cento::Point> path = cento::routePath(plane, from, to, width);
+            const i64 best = gridRoute(plane, {{-20, -20}, {80, 80}}, from, to, width);
+
+            // the tiles find a way exactly when the grid does, never shorter
+            expect((best < 0) == path.empty());
+            if (path.empty()) { continue; }
+
+            expect(path.front() == from);
+            expect(path.back() == to);
+            expect(isClear(plane, path, width));
+            expect(length(path) >= best);
+
+            // a plane of the blockages built up front gives the same route
+            cento::Plane wires;
+            cento::wirePlane(plane, wires, width);
+            expect(cento::routePath(wires, from, to, 1) == path);
+        }
+    };
+};
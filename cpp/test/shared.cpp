@@ -0,0 +1,244 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoRemove.hpp"
+#include "cento/centoShared.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace boost::ut;
+
+suite shared = []()
+{
+    "reader"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+
+        cento::Tile* const hint = plane.hint;
+
+        cento::PlaneReader reader(plane);
+        expect(cento::findTileAt(reader, {5, 5})->id == 1);
+        expect(isSpace(cento::findTileAt(reader, {50, 50})));
+        expect(not cento::empty(reader, {{-5, -5}, {5, 5}}));
+        expect(cento::empty(reader, {{20, 20}, {30, 30}}));
+
+        usize count = 0;
+        cento::querySolid(reader, {{-5, -5}, {50, 50}}, [&](cento::Tile*) { ++count; });
+        expect(count == 1);
+
+        // the reader never moves the hint of the plane
+        expect(plane.hint == hint);
+    };
+
+    "stress"_test = []()
+    {
+        cento::SharedPlane shared;
+        cento::write(shared, [](cento::Plane& p) { cento::createUniverse(p); });
+
+        // a fixed row of tiles which is never edited, the writer churns tiles
+        // in the row above it
+        cento::write(shared, [](cento::Plane& p)
+        {
+            for (i32 i = 0; i < 32; ++i)
+            {
+                cento::insertTile(p, {.id = u64(i), .rect = {{i * 20, 0}, {i * 20 + 10, 10}}});
+            }
+        });
+
+        std::atomic<bool> done{false};
+        std::atomic<usize> failures{0};
+
+        auto reader = [&](const i32 seed)
+        {
+            i32 i = seed;
+            while (not done.load(std::memory_order_relaxed))
+            {
+                i = (i * 7 + 3) % 32;
+                cento::read(shared, [&](cento::PlaneReader& r)
+                {
+                    const cento::Tile* t = cento::findTileAt(r, {i * 20 + 5, 5});
+                    if ((t == nullptr) || (t->id != u64(i))) { failures.fetch_add(1); }
+
+                    if (cento::empty(r, {{i * 20, 0}, {i * 20 + 10, 10}})) { failures.fetch_add(1); }
+
+                    usize count = 0;
+                    cento::querySolid(r, {{0, 0}, {640, 10}}, [&](cento::Tile*) { ++count; });
+                    if (count != 32) { failures.fetch_add(1); }
+
+                    cento::query(r, {{0, 10}, {640, 40}}, [&](cento::Tile* tile)
+                    {
+                        if (isSolid(tile) && (tile->id < 100)) { failures.fetch_add(1); }
+                    });
+                });
+            }
+        };
+
+        std::vector<std::jthread> readers;
+        for (i32 i = 0; i < 4; ++i) { readers.emplace_back(reader, i); }
+
+        for (i32 round = 0; round < 200; ++round)
+        {
+            const i32 x = (round * 13) % 600;
+
+            cento::Tile* t = cento::write(shared, [&](cento::Plane& p)
+            {
+                return cento::insertTile(p, {.id = u64(100 + round), .rect = {{x, 20}, {x + 30, 30}}});
+            });
+
+            cento::write(shared, [&](cento::Plane& p) { cento::removeTile(p, t); });
+        }
+
+        done = true;
+        readers.clear();
+
+        expect(failures.load() == 0);
+    };
+
+    "epochs"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+        cento::enableEpochs(plane);
+
+        std::vector<cento::Tile*> seen;
+
+        cento::Tile* const dead = cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        {
+            const cento::EpochGuard guard = cento::pin(plane);
+
+            cento::removeTile(plane, dead);
+            for (i32 i = 0; i < 64; ++i)
+            {
+                cento::Tile* t = cento::insertTile(plane, {.id = u64(i), .rect = {{i * 20, 0}, {i * 20 + 10, 10}}});
+                seen.push_back(t);
+                cento::queryAll(plane, [&](cento::Tile* tile) { seen.push_back(tile); });
+                cento::removeTile(plane, t);
+            }
+
+            // nothing freed while the reader was pinned has been handed out again
+            expect(std::ranges::find(seen, dead) == seen.end());
+            expect(not plane.epochs->retired.empty());
+        }
+
+        cento::reclaim(plane);
+        expect(plane.epochs->retired.empty());
+    };
+
+    "pinned"_test = []()
+    {
+        cento::SharedPlane shared;
+        cento::write(shared, [](cento::Plane& p)
+        {
+            cento::createUniverse(p);
+            cento::enableEpochs(p);
+        });
+
+        std::atomic<bool>  done{false};
+        std::atomic<usize> failures{0};
+        std::atomic<usize> checked{0};
+        std::atomic<usize> edits{0};
+        std::atomic<usize> passes{0};
+
+        // each reader walks the whole plane several times over one pin, with
+        // the writer editing in between.  A tile which has left the plane
+        // while the reader is pinned is only retired, so it must never turn
+        // up in the plane again before the pin is released.
+        auto reader = [&]()
+        {
+            std::unordered_set<const cento::Tile*> last;
+            std::unordered_set<const cento::Tile*> live;
+            std::unordered_set<const cento::Tile*> gone;
+            while (not done.load(std::memory_order_relaxed))
+            {
+                const cento::EpochGuard guard = cento::pin(shared.plane);
+
+                last.clear();
+                gone.clear();
+                for (i32 pass = 0; pass < 8; ++pass)
+                {
+                    live.clear();
+                    cento::read(shared, [&](cento::PlaneReader& r)
+                    {
+                        cento::query(r, {{cento::nInfinity + 1, cento::nInfinity + 1},
+                                         {cento::pInfinity - 1, cento::pInfinity - 1}},
+                                     [&](cento::Tile* t) { live.insert(t); });
+                    });
+
+                    for (const cento::Tile* t : last)
+                    {
+                        if (not live.contains(t)) { gone.insert(t); }
+                    }
+                    for (const cento::Tile* t : live)
+                    {
+                        if (gone.contains(t)) { failures.fetch_add(1); }
+                    }
+                    checked.fetch_add(gone.size(), std::memory_order_relaxed);
+
+                    std::swap(last, live);
+                    passes.fetch_add(1);
+
+                    // wait for the writer so every pass sees a different plane
+                    const usize seen = edits.load();
+                    while ((edits.load() == seen) && not done.load()) { std::this_thread::yield(); }
+                }
+            }
+        };
+
+        std::vector<std::jthread> readers;
+        for (i32 i = 0; i < 4; ++i) { readers.emplace_back(reader); }
+
+        // the writer in turn waits for a walk after each of its edits
+        auto edited = [&]()
+        {
+            const usize seen = passes.load();
+            edits.fetch_add(1);
+            while (passes.load() == seen) { std::this_thread::yield(); }
+        };
+
+        // the writer keeps sixteen posts standing, taking down the oldest and
+        // then putting up a new one, so the readers walk the plane between a
+        // tile being freed and the allocator handing it out again
+        for (u64 round = 0; round < 2000; ++round)
+        {
+            if (round >= 16)
+            {
+                const i32 x = i32(((round - 16) * 37) % 640);
+                cento::write(shared, [&](cento::Plane& p) { cento::removeTile(p, cento::findTileAt(p, {x, 5})); });
+                edited();
+            }
+
+            const i32 x = i32((round * 37) % 640);
+            cento::write(shared, [&](cento::Plane& p)
+            {
+                cento::insertTile(p, {.id = round, .rect = {{x, 0}, {x + 1, 10}}});
+            });
+            edited();
+        }
+
+        done = true;
+        readers.clear();
+
+        expect(failures.load() == 0);
+        expect(checked.load() > 0);
+
+        cento::write(shared, [](cento::Plane& p) { cento::reclaim(p); });
+        expect(shared.plane.epochs->retired.empty());
+    };
+};
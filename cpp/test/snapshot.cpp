@@ -0,0 +1,195 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoRemove.hpp"
+#include "cento/centoSnapshot.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    using Layout = std::vector<std::tuple<i32, i32, i32, i32, u64>>;
+
+    const cento::Rect everywhere{{-1000, -1000}, {1000, 1000}};
+
+    void add(Layout& layout, const cento::Tile* t)
+    {
+        const cento::Rect r = getRect(t);
+        layout.emplace_back(r.ll.x, r.ll.y, r.ur.x, r.ur.y, t->id);
+    }
+
+    Layout layoutOf(const cento::Plane& plane)
+    {
+        Layout layout;
+        cento::query(plane, everywhere, [&](cento::Tile* t) { add(layout, t); });
+        std::ranges::sort(layout);
+
+        return layout;
+    }
+
+    Layout layoutOf(cento::Snapshot& snap)
+    {
+        Layout layout;
+        cento::query(snap, everywhere, [&](const cento::Tile* t) { add(layout, t); });
+        std::ranges::sort(layout);
+
+        return layout;
+    }
+
+    // randomly insert and remove small tiles within a 400 x 400 area
+    struct Editor
+    {
+        cento::Plane&              plane;
+        std::vector<cento::Tile*>  tiles = {};
+        u32                        seed = 1;
+        u64                        id   = 0;
+
+        u32 next()
+        {
+            seed = seed * 1103515245u + 12345u;
+            return seed >> 8;
+        }
+
+        void step()
+        {
+            if (not tiles.empty() && (next() % 3 == 0))
+            {
+                const usize i = next() % tiles.size();
+                cento::removeTile(plane, tiles[i]);
+                tiles.erase(tiles.begin() + i);
+                return;
+            }
+
+            const i32 x = i32(next() % 400);
+            const i32 y = i32(next() % 400);
+            const i32 w = i32(next() % 30) + 1;
+            const i32 h = i32(next() % 30) + 1;
+            if (cento::Tile* t = cento::insertTile(plane, {.id = id++, .rect = {{x, y}, {x + w, y + h}}}))
+            {
+                tiles.push_back(t);
+            }
+        }
+    };
+
+}
+
+suite snapshot = []()
+{
+    "unchanged"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        Editor editor{.plane = plane};
+        for (usize i = 0; i < 200; ++i) { editor.step(); }
+
+        const Layout before = layoutOf(plane);
+
+        cento::Snapshot snap = cento::snapshot(plane);
+        expect(layoutOf(snap) == before);
+
+        for (usize i = 0; i < 500; ++i) { editor.step(); }
+
+        expect(layoutOf(plane) != before);
+        expect(layoutOf(snap) == before);
+
+        for (const auto& [lx, ly, ux, uy, id] : before)
+        {
+            if (id == cento::Space) { continue; }
+
+            const cento::Tile t = cento::findTileAt(snap, {lx, ly});
+            expect(t.id == id);
+            expect(cento::empty(snap, {{lx, ly}, {ux, uy}}) == false);
+        }
+    };
+
+    "generations"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        Editor editor{.plane = plane};
+        for (usize i = 0; i < 100; ++i) { editor.step(); }
+
+        const Layout first = layoutOf(plane);
+        cento::Snapshot a  = cento::snapshot(plane);
+
+        for (usize i = 0; i < 100; ++i) { editor.step(); }
+
+        const Layout second = layoutOf(plane);
+        cento::Snapshot b   = cento::snapshot(plane);
+        cento::Snapshot c   = b;
+
+        for (usize i = 0; i < 100; ++i) { editor.step(); }
+
+        expect(layoutOf(a) == first);
+        expect(layoutOf(b) == second);
+
+        // dropping the oldest snapshot keeps the newer ones intact
+        a = cento::Snapshot();
+        for (usize i = 0; i < 100; ++i) { editor.step(); }
+
+        expect(layoutOf(b) == second);
+        expect(plane.versions->generations.size() == 1);
+
+        b = cento::Snapshot();
+        expect(layoutOf(c) == second);
+
+        // once the last snapshot is gone nothing more is kept
+        c = cento::Snapshot();
+        expect(plane.versions->generations.empty());
+
+        for (usize i = 0; i < 100; ++i) { editor.step(); }
+        expect(plane.versions->reclaimed.empty());
+        expect(plane.versions->generations.empty());
+    };
+
+    "concurrent"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        Editor editor{.plane = plane};
+        for (usize i = 0; i < 200; ++i) { editor.step(); }
+
+        const Layout before = layoutOf(plane);
+
+        cento::Snapshot    snap = cento::snapshot(plane);
+        std::atomic<bool>  done{false};
+        std::atomic<usize> failures{0};
+
+        std::jthread reader([&, snap]() mutable
+        {
+            while (not done.load(std::memory_order_relaxed))
+            {
+                if (layoutOf(snap) != before) { failures.fetch_add(1); }
+            }
+        });
+
+        for (usize i = 0; i < 2000; ++i) { editor.step(); }
+
+        done = true;
+        reader.join();
+
+        expect(failures.load() == 0);
+        expect(layoutOf(snap) == before);
+    };
+};
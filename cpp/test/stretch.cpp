@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoCreate.hpp"
+#include "cento/centoExplore.hpp"
+#include "cento/centoInsert.hpp"
+#include "cento/centoStretch.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    std::vector<cento::Rect> rects(const cento::Plane& plane)
+    {
+        std::vector<cento::Rect> all;
+        cento::queryAll(plane, [&](cento::Tile* t) { all.push_back(getRect(t)); });
+        std::ranges::sort(all);
+
+        return all;
+    }
+
+    // No space tile may have space beside it.
+    bool isStrips(const cento::Plane& plane)
+    {
+        bool strips = true;
+        cento::queryAll(plane, [&](cento::Tile* t)
+        {
+            if (isSolid(t)) { return; }
+            for (cento::Tile* r = topRight(t); (r != nullptr) && (getTop(r) > getBottom(t)); r = leftBottom(r))
+            {
+                strips = strips && isSolid(r);
+            }
+        });
+
+        return strips;
+    }
+
+}
+
+suite stretch = []()
+{
+    "horizontal"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::Tile* const a = cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::Tile* const b = cento::insertTile(plane, {.id = 2, .rect = {{20, 0}, {30, 10}}});
+        cento::Tile* const c = cento::insertTile(plane, {.id = 3, .rect = {{5, 20}, {25, 30}}});
+        const std::vector<cento::Rect> before = rects(plane);
+
+        expect(cento::stretch(plane, 15, 10, cento::Axis::Horizontal));
+
+        // the tiles beyond the line move and those it passes through grow
+        expect(getRect(a) == cento::Rect{{0, 0}, {10, 10}});
+        expect(getRect(b) == cento::Rect{{30, 0}, {40, 10}});
+        expect(getRect(c) == cento::Rect{{5, 20}, {35, 30}});
+        expect(getRect(cento::findTileAt(plane, {25, 5})) == cento::Rect{{10, 0}, {30, 10}});
+        expect(isStrips(plane));
+
+        // closing the band puts everything back
+        expect(cento::stretch(plane, 15, -10, cento::Axis::Horizontal));
+        expect(rects(plane) == before);
+    };
+
+    "vertical"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::Tile* const a = cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::Tile* const b = cento::insertTile(plane, {.id = 2, .rect = {{0, 20}, {10, 30}}});
+        cento::Tile* const c = cento::insertTile(plane, {.id = 3, .rect = {{20, 5}, {30, 25}}});
+
+        expect(cento::stretch(plane, 12, 100, cento::Axis::Vertical));
+
+        expect(getRect(a) == cento::Rect{{0, 0}, {10, 10}});
+        expect(getRect(b) == cento::Rect{{0, 120}, {10, 130}});
+        expect(getRect(c) == cento::Rect{{20, 5}, {30, 125}});
+        expect(cento::findTileAt(plane, {5, 125}) == b);
+        expect(isSpace(cento::findTileAt(plane, {5, 60})));
+        expect(isStrips(plane));
+    };
+
+    "refused"_test = []()
+    {
+        cento::Plane plane;
+        cento::createUniverse(plane);
+
+        cento::insertTile(plane, {.id = 1, .rect = {{0, 0}, {10, 10}}});
+        cento::insertTile(plane, {.id = 2, .rect = {{20, 0}, {30, 10}}});
+        const std::vector<cento::Rect> before = rects(plane);
+
+        // the band would cut through the second tile, or swallow the space
+        // between the two whole
+        expect(not cento::stretch(plane, 15, -10, cento::Axis::Horizontal));
+        expect(not cento::stretch(plane, 10, -10, cento::Axis::Horizontal));
+        expect(rects(plane) == before);
+
+        // the space between them is narrowed, the tile beyond follows it
+        expect(cento::stretch(plane, 12, -5, cento::Axis::Horizontal));
+        expect(getRect(cento::findTileAt(plane, {16, 5})) == cento::Rect{{15, 0}, {25, 10}});
+    };
+};
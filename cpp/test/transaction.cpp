@@ -0,0 +1,178 @@
+//
+// Copyright (C) 2022 by Oliver John Hitchcock - github.com/c0rp3n
+//
+// Distributed under the Boost Software License, Version 1.0.
+//
+
+#define BOOST_UT_DISABLE_MODULE
+#include <boost/ut.hpp>
+
+#include "cento/cento.hpp"
+#include "cento/centoTransaction.hpp"
+
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace boost::ut;
+
+namespace
+{
+
+    /*
+     * Courses of bricks ten units high, each course shifted along by half a
+     * brick so that no two gaps line up and every space tile is a single gap.
+     */
+    void layBricks(cento::TransactionalPlane& tp, const i32 width, const i32 courses)
+    {
+        cento::createUniverse(tp);
+        for (i32 c = 0; c < courses; ++c)
+        {
+            for (i32 x = (c % 2) * 10; x < width; x += 20)
+            {
+                cento::insertTile(tp, {.id = 1, .rect = {{x, c * 10}, {x + 10, c * 10 + 10}}});
+            }
+        }
+    }
+
+    // Lift each brick in the area out and put it back, filling and clearing
+    // the gap next to it on the way.
+    void rework(cento::TransactionalPlane& tp, const cento::Rect& area)
+    {
+        for (i32 y = area.ll.y; y < area.ur.y; y += 10)
+        {
+            for (i32 x = area.ll.x + ((y / 10) % 2) * 10; x < area.ur.x; x += 20)
+            {
+                cento::Tile* const brick = cento::read(tp, [&](cento::PlaneReader& r)
+                {
+                    return cento::findTileAt(r, {x, y});
+                });
+
+                cento::removeTile(tp, brick);
+                cento::Tile* const placed = cento::insertTile(tp, {.id = 1, .rect = {{x, y}, {x + 10, y + 10}}});
+                expect(placed != nullptr);
+
+                cento::Tile* const filler = cento::insertTile(tp, {.id = 2, .rect = {{x + 12, y + 2}, {x + 18, y + 8}}});
+                expect(filler != nullptr);
+                cento::removeTile(tp, filler);
+            }
+        }
+    }
+
+}
+
+suite transaction = []()
+{
+    "footprint"_test = []()
+    {
+        cento::TransactionalPlane tp;
+        layBricks(tp, 400, 20);
+
+        cento::Tile*          start = nullptr;
+        cento::Rect           box   = {};
+        cento::detail::Search all{.held = {{cento::nInfinity, cento::nInfinity}, {cento::pInfinity, cento::pInfinity}}};
+
+        // deep inside the bricks the footprint only reaches a few bricks away
+        const cento::Rect inner{{200, 100}, {210, 110}};
+        expect(cento::detail::footprint(all, tp.plane.hint, inner, box, start));
+        expect(cento::contains(box, inner.ll));
+        expect(box.ll.x > 100 && box.ur.x < 300);
+        expect(box.ll.y > 50 && box.ur.y < 150);
+        expect(start == cento::findTileAt(tp.plane, {200, 109}));
+
+        // a search held to the area around the edit has to reach further
+        cento::detail::Search held{.held = cento::detail::touching(inner)};
+        expect(not cento::detail::footprint(held, start, inner, box, start));
+        expect(not cento::contains(held.held, held.missed.ll));
+
+        // at the edge of the bricks it runs off to infinity
+        expect(cento::detail::footprint(all, tp.plane.hint, {{200, 190}, {210, 200}}, box, start));
+        expect(box.ur.y == cento::pInfinity);
+    };
+
+    "parallel"_test = []()
+    {
+        cento::TransactionalPlane tp;
+        layBricks(tp, 1600, 40);
+
+        const StitchLayout before = stitchLayoutOf(tp.plane);
+
+        // each worker keeps to a column of its own, well clear of the others
+        std::vector<std::thread> workers;
+        for (i32 w = 0; w < 4; ++w)
+        {
+            workers.emplace_back([&tp, w]()
+            {
+                rework(tp, {{w * 400 + 100, 100}, {w * 400 + 300, 300}});
+            });
+        }
+        for (std::thread& t : workers) { t.join(); }
+
+        expect(tp.regions.empty());
+        expect(stitchLayoutOf(tp.plane) == before);
+    };
+
+    "overlapping"_test = []()
+    {
+        cento::TransactionalPlane tp;
+        layBricks(tp, 1600, 40);
+
+        // an edit far from one in flight starts and finishes while the first
+        // is still going, the first gives up waiting for it after a while
+        std::atomic<bool> started{false};
+        std::atomic<bool> finished{false};
+        bool              overlapped = false;
+
+        std::thread first([&]()
+        {
+            cento::transact(tp, {{112, 102}, {118, 108}}, [&](cento::Plane& lane)
+            {
+                cento::Tile* const t = cento::insertTile(lane, {.id = 2, .rect = {{112, 102}, {118, 108}}});
+                started = true;
+
+                const auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                while (not finished && (std::chrono::steady_clock::now() < until)) { std::this_thread::yield(); }
+                overlapped = finished;
+
+                cento::removeTile(lane, t);
+            });
+        });
+
+        while (not started) { std::this_thread::yield(); }
+        cento::Tile* const t = cento::insertTile(tp, {.id = 2, .rect = {{1312, 102}, {1318, 108}}});
+        cento::removeTile(tp, t);
+        finished = true;
+
+        first.join();
+
+        expect(overlapped);
+        expect(tp.regions.empty() && tp.searches.empty());
+    };
+
+    "conflicting"_test = []()
+    {
+        cento::TransactionalPlane tp;
+        layBricks(tp, 400, 20);
+
+        const StitchLayout before = stitchLayoutOf(tp.plane);
+
+        // neighbouring rows overlap their footprints so the edits take turns
+        std::vector<std::thread> workers;
+        for (i32 w = 0; w < 4; ++w)
+        {
+            workers.emplace_back([&tp, w]()
+            {
+                rework(tp, {{100, 60 + w * 20}, {300, 80 + w * 20}});
+            });
+        }
+        for (std::thread& t : workers) { t.join(); }
+
+        expect(tp.regions.empty());
+        expect(stitchLayoutOf(tp.plane) == before);
+    };
+};
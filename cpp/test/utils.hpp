@@ -10,10 +10,13 @@
 #pragma once
 
 #include "cento/centoCreate.hpp"
+#include "cento/centoExplore.hpp"
 #include "cento/centoTilePlan.hpp"
 #include "cento/centoPlane.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <tuple>
 #include <vector>
 
 using TilingPlan = std::vector<cento::TilePlan>;
@@ -89,6 +92,34 @@ inline TileVec createTiles(cento::Plane& plane, const TilingPlan& plan)
     return tiles;
 }
 
+using TileKey      = std::tuple<i32, i32, i32, i32, u64>;
+using StitchLayout = std::vector<std::tuple<TileKey, TileKey, TileKey, TileKey, TileKey>>;
+
+inline TileKey keyOf(const cento::Tile* t)
+{
+    if (t == nullptr) { return {0, 0, 0, 0, 0}; }
+
+    const cento::Rect r = getRect(t);
+    return {r.ll.x, r.ll.y, r.ur.x, r.ur.y, t->id};
+}
+
+// every tile along with the tiles its four stitches point at
+inline StitchLayout stitchLayoutOf(const cento::Plane& plane)
+{
+    StitchLayout layout;
+    cento::queryAll(plane, [&](cento::Tile* t)
+    {
+        layout.emplace_back(keyOf(t),
+                            keyOf(leftBottom(t)),
+                            keyOf(bottomLeft(t)),
+                            keyOf(rightTop(t)),
+                            keyOf(topRight(t)));
+    });
+    std::ranges::sort(layout);
+
+    return layout;
+}
+
 CENTO_BEGIN_NAMESPACE
 
 inline std::ostream& operator<<(std::ostream& to, const Point& put)